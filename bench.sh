@@ -0,0 +1,25 @@
+#! /bin/bash
+# purpose: compiles and runs the hot path benchmarks and keeps their json results
+
+# capture run label (any further arguments are passed to the benchmarks)
+label=${1:-$(date +%Y%m%d_%H%M%S)}
+
+# build flavor, release unless BJ_FLAVOR is set to native or lto
+flavor=${BJ_FLAVOR:-release}
+buildDir=$(pwd)/build/${flavor}
+
+# create results dir
+mkdir -p benchmarks
+
+# compile cpp prog, the harness counts allocations itself so the tracker stays off
+cmake -S . -B ${buildDir} -DBJ_FLAVOR=${flavor} -DBJ_ALLOC_TRACKING=0 > /dev/null || exit 1
+cmake --build ${buildDir} --parallel --target bench || exit 1
+
+# run prog
+cd src
+${buildDir}/bench ${label} "${@:2}"
+
+# move result file
+mv Bench_${label}.json ../benchmarks/Bench_${label}.json
+
+cd ..
@@ -0,0 +1,131 @@
+# purpose: shared steps for the pgo and flavors scripts, configuring and building a
+#          flavor in its own directory and running the training and eval workload
+
+# whole part of a rate the programs printed, which may be in scientific notation
+function(bj_whole_number value outVar)
+
+    if(value MATCHES "^([0-9]+)\\.?([0-9]*)e\\+([0-9]+)$")
+
+        # shift the fraction digits into the whole part
+        set(digits "${CMAKE_MATCH_1}${CMAKE_MATCH_2}0000000000000000")
+        string(LENGTH "${CMAKE_MATCH_1}" wholeLength)
+        math(EXPR wholeLength "${wholeLength} + ${CMAKE_MATCH_3}")
+        string(SUBSTRING "${digits}" 0 ${wholeLength} value)
+
+    endif()
+    string(REGEX REPLACE "\\..*" "" value "${value}")
+
+    set(${outVar} ${value} PARENT_SCOPE)
+
+endfunction()
+
+# configures and builds the driver and eval (or every program) of a flavor
+# FLAVOR_ARGS and any extra arguments are passed to the configure step
+function(bj_build_flavor buildDir flavor allPrograms)
+
+    set(compilerArgs)
+    if(CXX_COMPILER)
+        set(compilerArgs -DCMAKE_CXX_COMPILER=${CXX_COMPILER})
+    endif()
+
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${buildDir} -DCMAKE_BUILD_TYPE=Release -DBJ_FLAVOR=${flavor} ${compilerArgs} ${FLAVOR_ARGS} ${ARGN}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Configuring the ${flavor} flavor failed")
+    endif()
+
+    set(targets --target driver eval)
+    if(allPrograms)
+        set(targets)
+    endif()
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} --build ${buildDir} --parallel ${targets}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Building the ${flavor} flavor failed")
+    endif()
+
+endfunction()
+
+# trains a chart on a few games with a flavor's driver then evaluates it with its eval
+# the work dir is laid out like the repo so the programs find ../charts
+# gives back the driver's games/sec and eval's hands/sec as whole numbers
+function(bj_run_workload binDir workDir gamesPerSecVar handsPerSecVar)
+
+    file(REMOVE_RECURSE ${workDir})
+    file(MAKE_DIRECTORY ${workDir}/src ${workDir}/charts/Chartworkload)
+
+    # short training run, no progress lines
+    execute_process(
+        COMMAND ${binDir}/driver workload --games ${GAMES} --progress-seconds 1000000
+        WORKING_DIRECTORY ${workDir}/src
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Workload training in ${binDir} failed")
+    endif()
+    file(STRINGS ${workDir}/src/workload_parameters.txt gamesLine REGEX "games/sec: ")
+    string(REGEX REPLACE ".*games/sec: ([0-9.e+]+).*" "\\1" gamesPerSec "${gamesLine}")
+
+    # short eval of the new chart on one thread
+    file(RENAME ${workDir}/src/Chartworkload_readable.csv ${workDir}/charts/Chartworkload/Chartworkload_readable.csv)
+    execute_process(
+        COMMAND ${binDir}/eval workload --seed 1 --threads 1 --rounds ${ROUNDS}
+        WORKING_DIRECTORY ${workDir}/src
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE evalOutput
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Workload eval in ${binDir} failed:\n${evalOutput}")
+    endif()
+    string(REGEX MATCH "\\(([0-9.e+]+) hands/sec\\)" handsMatch "${evalOutput}")
+
+    set(handsPerSec ${CMAKE_MATCH_1})
+    if(NOT gamesPerSec OR NOT handsPerSec)
+        message(FATAL_ERROR "Couldn't read the workload rates in ${workDir}")
+    endif()
+
+    bj_whole_number(${gamesPerSec} gamesPerSec)
+    bj_whole_number(${handsPerSec} handsPerSec)
+    set(${gamesPerSecVar} ${gamesPerSec} PARENT_SCOPE)
+    set(${handsPerSecVar} ${handsPerSec} PARENT_SCOPE)
+
+endfunction()
+
+# two stage profile guided build
+# the instrumented stage runs the workload in the same build dir, so the profile
+# lines up with the objects the second stage rebuilds
+function(bj_build_pgo buildDir)
+
+    set(profileDir ${buildDir}/profile)
+    file(REMOVE_RECURSE ${profileDir})
+
+    # instrumented build and its profile
+    message(STATUS "pgo: building instrumented programs")
+    bj_build_flavor(${buildDir} pgo-generate FALSE -DBJ_PROFILE_DIR=${profileDir})
+    message(STATUS "pgo: running the workload (${GAMES} games, ${ROUNDS} eval rounds)")
+    bj_run_workload(${buildDir} ${buildDir}/workload gamesPerSec handsPerSec)
+
+    # clang writes raw profiles that have to be merged
+    file(GLOB rawProfiles ${profileDir}/*.profraw)
+    if(rawProfiles)
+
+        find_program(LLVM_PROFDATA NAMES llvm-profdata)
+        if(NOT LLVM_PROFDATA)
+            message(FATAL_ERROR "Merging the clang profile needs llvm-profdata")
+        endif()
+        execute_process(COMMAND ${LLVM_PROFDATA} merge -output=${profileDir}/default.profdata ${rawProfiles})
+
+    endif()
+
+    # optimized build with the profile
+    message(STATUS "pgo: building with the profile")
+    bj_build_flavor(${buildDir} pgo-use TRUE -DBJ_PROFILE_DIR=${profileDir})
+
+endfunction()
@@ -0,0 +1,95 @@
+# purpose: builds every flavor, times each on the training and eval workload and
+#          writes a comparison to benchmarks/Flavors_<date>.txt
+# usage: cmake -DSOURCE_DIR=<repo> -DFLAVORS_DIR=<dir> [-DGAMES=n] [-DROUNDS=n] [-DREPEATS=n] [-DCXX_COMPILER=c++] -P cmake/Flavors.cmake
+#        (or cmake --build <build> --target flavors)
+
+include(${CMAKE_CURRENT_LIST_DIR}/FlavorTools.cmake)
+
+# workload defaults match CMakeLists.txt, the best of a few runs is kept
+if(NOT GAMES)
+    set(GAMES 3000000)
+endif()
+if(NOT ROUNDS)
+    set(ROUNDS 5000)
+endif()
+if(NOT REPEATS)
+    set(REPEATS 3)
+endif()
+
+set(flavors release native lto pgo)
+
+# build
+foreach(flavor ${flavors})
+
+    message(STATUS "flavors: building ${flavor}")
+    if(flavor STREQUAL "pgo")
+        bj_build_pgo(${FLAVORS_DIR}/pgo)
+    else()
+        bj_build_flavor(${FLAVORS_DIR}/${flavor} ${flavor} FALSE)
+    endif()
+
+endforeach()
+
+# time, flavors take turns so drift in machine load is spread over all of them
+foreach(flavor ${flavors})
+    set(bestGames_${flavor} 0)
+    set(bestHands_${flavor} 0)
+endforeach()
+foreach(repeat RANGE 1 ${REPEATS})
+    foreach(flavor ${flavors})
+
+        message(STATUS "flavors: timing ${flavor} (run ${repeat} of ${REPEATS})")
+        bj_run_workload(${FLAVORS_DIR}/${flavor} ${FLAVORS_DIR}/${flavor}/workload gamesPerSec handsPerSec)
+        if(gamesPerSec GREATER bestGames_${flavor})
+            set(bestGames_${flavor} ${gamesPerSec})
+        endif()
+        if(handsPerSec GREATER bestHands_${flavor})
+            set(bestHands_${flavor} ${handsPerSec})
+        endif()
+
+    endforeach()
+endforeach()
+
+# report, speedups are against release
+string(TIMESTAMP label "%Y%m%d_%H%M%S")
+set(reportPath ${SOURCE_DIR}/benchmarks/Flavors_${label}.txt)
+set(report "Build flavors on the workload: ${GAMES} training games, ${ROUNDS} eval rounds on 1 thread, best of ${REPEATS}\n\n")
+string(APPEND report "flavor        ")
+foreach(cell "train games/sec" "vs release" "eval hands/sec" "vs release")
+    string(LENGTH "${cell}" length)
+    math(EXPR padding "15 - ${length}")
+    string(REPEAT " " ${padding} pad)
+    string(APPEND report "  ${pad}${cell}")
+endforeach()
+string(APPEND report "\n")
+foreach(flavor ${flavors})
+
+    # cmake math is integer only, speedups are kept in thousandths
+    set(games ${bestGames_${flavor}})
+    set(hands ${bestHands_${flavor}})
+    math(EXPR gamesSpeedup "1000 * ${games} / ${bestGames_release}")
+    math(EXPR handsSpeedup "1000 * ${hands} / ${bestHands_release}")
+    foreach(speedup gamesSpeedup handsSpeedup)
+        math(EXPR whole "${${speedup}} / 1000")
+        math(EXPR fraction "${${speedup}} % 1000 + 1000")
+        string(SUBSTRING ${fraction} 1 3 fraction)
+        set(${speedup} "${whole}.${fraction}x")
+    endforeach()
+
+    string(LENGTH "${flavor}" length)
+    math(EXPR padding "14 - ${length}")
+    string(REPEAT " " ${padding} pad)
+    string(APPEND report "${flavor}${pad}")
+    foreach(cell "${games}" "${gamesSpeedup}" "${hands}" "${handsSpeedup}")
+        string(LENGTH "${cell}" length)
+        math(EXPR padding "15 - ${length}")
+        string(REPEAT " " ${padding} pad)
+        string(APPEND report "  ${pad}${cell}")
+    endforeach()
+    string(APPEND report "\n")
+
+endforeach()
+
+file(WRITE ${reportPath} "${report}")
+message("\n${report}")
+message(STATUS "flavors: report written to ${reportPath}")
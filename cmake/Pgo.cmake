@@ -0,0 +1,17 @@
+# purpose: two stage profile guided build of every program
+# usage: cmake -DSOURCE_DIR=<repo> -DBUILD_DIR=<dir> [-DGAMES=n] [-DROUNDS=n] [-DCXX_COMPILER=c++]
+#              [-DFLAVOR_ARGS=-DBJ_TRACE=1;...] -P cmake/Pgo.cmake
+#        (or cmake --build <build> --target pgo)
+
+include(${CMAKE_CURRENT_LIST_DIR}/FlavorTools.cmake)
+
+# workload defaults match CMakeLists.txt
+if(NOT GAMES)
+    set(GAMES 3000000)
+endif()
+if(NOT ROUNDS)
+    set(ROUNDS 5000)
+endif()
+
+bj_build_pgo(${BUILD_DIR})
+message(STATUS "pgo: programs are in ${BUILD_DIR}")
@@ -0,0 +1,23 @@
+#! /bin/bash
+# purpose: compiles and runs the performance regression check against the stored baseline
+# run with --update to write a new baseline instead (arguments are passed to perfcheck)
+
+# build flavor, release unless BJ_FLAVOR is set to native or lto
+# a baseline is only comparable with runs of the same flavor on the same machine
+flavor=${BJ_FLAVOR:-release}
+buildDir=$(pwd)/build/${flavor}
+
+# create baseline dir
+mkdir -p benchmarks
+
+# compile cpp prog, the harness counts allocations itself so the tracker stays off
+cmake -S . -B ${buildDir} -DBJ_FLAVOR=${flavor} -DBJ_ALLOC_TRACKING=0 > /dev/null || exit 1
+cmake --build ${buildDir} --parallel --target perfcheck || exit 1
+
+# run prog, its exit code says whether anything regressed
+cd src
+${buildDir}/perfcheck "$@"
+status=$?
+
+cd ..
+exit ${status}
@@ -0,0 +1,16 @@
+#! /bin/bash
+# purpose: compiles and runs the results store tool (arguments are passed to it)
+# ./results.sh import brings in the charts' text files, then ./results.sh query ... searches them
+
+# compile cpp prog
+buildDir=$(pwd)/build/release
+cmake -S . -B ${buildDir} > /dev/null || exit 1
+cmake --build ${buildDir} --parallel --target results > /dev/null || exit 1
+
+# run prog
+cd src
+${buildDir}/results "$@"
+status=$?
+
+cd ..
+exit ${status}
@@ -1,43 +1,78 @@
 #! /bin/bash
 # purpose: compiles, runs and reorganizes files for driver
 
-# capture run num
+# capture run num (any further arguments are passed to the driver)
 runNum=$1
 
+# run with BJ_TRACE=1 set to build with tracing zones and keep the traces
+traceFlag=""
+if [ "${BJ_TRACE}" = "1" ]; then
+    traceFlag="-DBJ_TRACE=1"
+fi
+
+# run with BJ_ALLOC_TRACKING=1 set to count allocations by subsystem and keep the reports
+allocFlag=""
+if [ "${BJ_ALLOC_TRACKING}" = "1" ]; then
+    allocFlag="-DBJ_ALLOC_TRACKING=1"
+fi
+
+# run with BJ_FLAVOR set to release (the default), native, lto or pgo to pick the build
+# pgo builds twice, training on a short workload in between
+flavor=${BJ_FLAVOR:-release}
+buildDir=$(pwd)/build/${flavor}
+buildArgs="-DBJ_TRACE=${BJ_TRACE:-0} -DBJ_ALLOC_TRACKING=${BJ_ALLOC_TRACKING:-0}"
+
+# compile cpp progs
+if [ "${flavor}" = "pgo" ]; then
+    cmake -DSOURCE_DIR=$(pwd) -DBUILD_DIR=${buildDir} "-DFLAVOR_ARGS=${buildArgs// /;}" -P cmake/Pgo.cmake || exit 1
+else
+    cmake -S . -B ${buildDir} -DBJ_FLAVOR=${flavor} ${buildArgs} > /dev/null || exit 1
+    cmake --build ${buildDir} --parallel --target driver eval chartc || exit 1
+fi
+
 # create new dir
 mkdir charts/Chart${runNum}
 
-# compile cpp prog
-cd src
-g++ driver.cpp -Wall -o driver.exe
-
 # run prog
-./driver.exe ${runNum}
+cd src
+${buildDir}/driver ${runNum} "${@:2}"
 
 # result filepaths
 CHART_NAME="Chart${runNum}.csv"
 USABLE_CHART_NAME="Chart${runNum}_readable.csv"
 MAX_TRAINING_CHART_NAME="Chart${runNum}_backing.csv"
 Q_CHART_NAME="Chart${runNum}_Q.csv"
+CI_CHART_NAME="Chart${runNum}_CI.csv"
 TRAINING_CHART_NAME="Chart${runNum}_wholeBacking.csv"
 PARAM_FILE_NAME="${runNum}_parameters.txt"
+COUNTERS_JSON_NAME="${runNum}_counters.json"
+COUNTERS_PROM_NAME="${runNum}_counters.prom"
+Q_LOG_NAME="Chart${runNum}_qlog.bin"
 
 # move all result files
 mv ${CHART_NAME} ../charts/Chart${runNum}/${CHART_NAME}
 mv ${USABLE_CHART_NAME} ../charts/Chart${runNum}/${USABLE_CHART_NAME}
 mv ${MAX_TRAINING_CHART_NAME} ../charts/Chart${runNum}/${MAX_TRAINING_CHART_NAME}
 mv ${Q_CHART_NAME} ../charts/Chart${runNum}/${Q_CHART_NAME}
+mv ${CI_CHART_NAME} ../charts/Chart${runNum}/${CI_CHART_NAME}
 mv ${TRAINING_CHART_NAME} ../charts/Chart${runNum}/${TRAINING_CHART_NAME}
 mv ${PARAM_FILE_NAME} ../charts/Chart${runNum}/${PARAM_FILE_NAME}
+mv ${COUNTERS_JSON_NAME} ../charts/Chart${runNum}/${COUNTERS_JSON_NAME}
+mv ${COUNTERS_PROM_NAME} ../charts/Chart${runNum}/${COUNTERS_PROM_NAME}
+if [ -f ${Q_LOG_NAME} ]; then
+    mv ${Q_LOG_NAME} ../charts/Chart${runNum}/${Q_LOG_NAME}
+fi
+if [ -n "${traceFlag}" ]; then
+    mv ${runNum}_trace.json ../charts/Chart${runNum}/${runNum}_trace.json
+fi
+if [ -n "${allocFlag}" ]; then
+    mv ${runNum}_alloc.txt ../charts/Chart${runNum}/${runNum}_alloc.txt
+fi
 
-# compile evaluation
-g++ eval.cpp -Wall -o eval.exe
-
-# run with chart id
-./eval.exe ${runNum}
+# check chart and write its packed forms
+${buildDir}/chartc ${runNum}
 
-# delete executables
-rm driver.exe
-rm eval.exe
+# run evaluation with chart id
+${buildDir}/eval ${runNum}
 
 cd ..
@@ -0,0 +1,36 @@
+#! /bin/bash
+# purpose: compiles, runs and reorganizes files for the exact strategy solver
+
+# capture run num and deck count (0 or missing for infinite deck)
+runNum=$1
+deckCount=${2:-0}
+
+# compile cpp prog
+buildDir=$(pwd)/build/release
+cmake -S . -B ${buildDir} > /dev/null || exit 1
+cmake --build ${buildDir} --parallel --target solver || exit 1
+
+# create new dir
+mkdir charts/Chart${runNum}
+
+# run prog
+cd src
+${buildDir}/solver ${runNum} ${deckCount}
+
+# result filepaths
+CHART_NAME="Chart${runNum}.csv"
+USABLE_CHART_NAME="Chart${runNum}_readable.csv"
+MAX_TRAINING_CHART_NAME="Chart${runNum}_backing.csv"
+Q_CHART_NAME="Chart${runNum}_Q.csv"
+TRAINING_CHART_NAME="Chart${runNum}_wholeBacking.csv"
+PARAM_FILE_NAME="${runNum}_parameters.txt"
+
+# move all result files
+mv ${CHART_NAME} ../charts/Chart${runNum}/${CHART_NAME}
+mv ${USABLE_CHART_NAME} ../charts/Chart${runNum}/${USABLE_CHART_NAME}
+mv ${MAX_TRAINING_CHART_NAME} ../charts/Chart${runNum}/${MAX_TRAINING_CHART_NAME}
+mv ${Q_CHART_NAME} ../charts/Chart${runNum}/${Q_CHART_NAME}
+mv ${TRAINING_CHART_NAME} ../charts/Chart${runNum}/${TRAINING_CHART_NAME}
+mv ${PARAM_FILE_NAME} ../charts/Chart${runNum}/${PARAM_FILE_NAME}
+
+cd ..
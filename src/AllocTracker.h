@@ -0,0 +1,262 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: heap allocation counts by subsystem and a guard for loops that shouldn't allocate
+*/
+
+// file guards
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+// tracking is off unless built with -DBJ_ALLOC_TRACKING=1
+// when on every new in the program is counted against the subsystem running it,
+// when off the scopes and guards compile to nothing
+#ifndef BJ_ALLOC_TRACKING
+#define BJ_ALLOC_TRACKING 0
+#endif
+
+// imports
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+
+// namespace
+using std::string;
+using std::ostream, std::endl;
+using std::setw, std::left, std::right;
+using std::atomic, std::memory_order_relaxed;
+
+// parts of the program allocations are counted against
+enum AllocSubsystem {
+
+    // anything not in a scope
+    ALLOC_OTHER,
+
+    // Dealer dealing and shuffling
+    ALLOC_SHOE,
+
+    // Game dealing, hits, splits and the dealer's turn
+    ALLOC_GAME,
+
+    // code playing a hand and its split branches (splits lists)
+    ALLOC_HAND_LOOP,
+
+    // agent moves, game histories and split histories
+    ALLOC_AGENT,
+
+    // agent training on a batch of games
+    ALLOC_TRAIN,
+
+    // eval bookkeeping around hands (bets, stats)
+    ALLOC_EVAL,
+
+    // chart reading and writing
+    ALLOC_CHART_IO
+
+};
+const int ALLOC_SUBSYSTEM_COUNT = 8;
+const string ALLOC_SUBSYSTEM_NAMES[] = {"other", "shoe", "game", "hand loop", "agent", "train", "eval", "chart io"};
+
+// true if this build counts allocations
+const bool ALLOC_TRACKING_BUILT = BJ_ALLOC_TRACKING;
+
+// allocations and bytes by subsystem, and allocations made inside a guard
+struct AllocSnapshot {
+
+    long long allocations[ALLOC_SUBSYSTEM_COUNT];
+    long long bytes[ALLOC_SUBSYSTEM_COUNT];
+    long long guarded;
+    int firstGuarded;
+
+};
+
+#if BJ_ALLOC_TRACKING
+
+// subsystem running on this thread and how many guards it is inside
+thread_local int allocSubsystem = ALLOC_OTHER;
+thread_local int allocGuardDepth = 0;
+
+// counts across threads
+atomic<long long> allocationCounts[ALLOC_SUBSYSTEM_COUNT];
+atomic<long long> allocationBytes[ALLOC_SUBSYSTEM_COUNT];
+atomic<long long> guardedAllocations(0);
+atomic<int> firstGuardedSubsystem(-1);
+
+// every new goes through here to be counted
+__attribute__((noinline)) void* operator new(size_t size) {
+
+    int subsystem = allocSubsystem;
+    allocationCounts[subsystem].fetch_add(1, memory_order_relaxed);
+    allocationBytes[subsystem].fetch_add(size, memory_order_relaxed);
+
+    // allocation where there shouldn't be one
+    if (allocGuardDepth > 0) {
+
+        guardedAllocations.fetch_add(1, memory_order_relaxed);
+        int none = -1;
+        firstGuardedSubsystem.compare_exchange_strong(none, subsystem);
+
+    }
+
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+
+}
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+
+    std::free(memory);
+
+}
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept {
+
+    std::free(memory);
+
+}
+
+// counts allocations in the rest of the scope against a subsystem
+class AllocScope {
+
+    private:
+
+        // subsystem to go back to
+        int previous;
+
+    public:
+
+        AllocScope(int subsystem) {
+
+            this->previous = allocSubsystem;
+            allocSubsystem = subsystem;
+
+        }
+
+        ~AllocScope() {
+
+            allocSubsystem = this->previous;
+
+        }
+
+};
+
+// counts any allocation in the rest of the scope as a guard failure if armed
+class AllocGuard {
+
+    private:
+
+        // guard is on
+        bool armed;
+
+    public:
+
+        AllocGuard(bool armed) {
+
+            this->armed = armed;
+            allocGuardDepth += armed ? 1 : 0;
+
+        }
+
+        ~AllocGuard() {
+
+            allocGuardDepth -= this->armed ? 1 : 0;
+
+        }
+
+};
+
+// current counts
+AllocSnapshot allocSnapshot() {
+
+    AllocSnapshot snapshot;
+    for (int s = 0; s < ALLOC_SUBSYSTEM_COUNT; s ++) {
+
+        snapshot.allocations[s] = allocationCounts[s].load(memory_order_relaxed);
+        snapshot.bytes[s] = allocationBytes[s].load(memory_order_relaxed);
+
+    }
+    snapshot.guarded = guardedAllocations.load(memory_order_relaxed);
+    snapshot.firstGuarded = firstGuardedSubsystem.load(memory_order_relaxed);
+
+    return snapshot;
+
+}
+
+#define BJ_ALLOC_JOIN_NAME(a, b) a##b
+#define BJ_ALLOC_NAME(a, b) BJ_ALLOC_JOIN_NAME(a, b)
+#define BJ_ALLOC_SCOPE(subsystem) AllocScope BJ_ALLOC_NAME(allocScope, __LINE__)(subsystem)
+#define BJ_ALLOC_GUARD(armed) AllocGuard BJ_ALLOC_NAME(allocGuard, __LINE__)(armed)
+
+#else
+
+// nothing is counted
+AllocSnapshot allocSnapshot() {
+
+    AllocSnapshot snapshot = {};
+    snapshot.firstGuarded = -1;
+
+    return snapshot;
+
+}
+
+#define BJ_ALLOC_SCOPE(subsystem)
+#define BJ_ALLOC_GUARD(armed)
+
+#endif
+
+// writes allocations and bytes by subsystem, per hand and per decision, and the
+// train subsystem per training batch, counts of 0 leave their columns out
+void writeAllocReport(ostream& out, const AllocSnapshot& snapshot, long long hands, long long decisions, long long batches) {
+
+    out << "Allocations by subsystem:" << endl;
+    out << left << setw(12) << "subsystem" << right << setw(14) << "allocs" << setw(16) << "bytes";
+    if (hands > 0) {
+        out << setw(14) << "allocs/hand" << setw(14) << "bytes/hand";
+    }
+    if (decisions > 0) {
+        out << setw(16) << "allocs/decision";
+    }
+    if (batches > 0) {
+        out << setw(14) << "allocs/batch";
+    }
+    out << endl;
+
+    long long totalAllocations = 0;
+    long long totalBytes = 0;
+    for (int s = 0; s <= ALLOC_SUBSYSTEM_COUNT; s ++) {
+
+        // subsystems then the total
+        bool total = s == ALLOC_SUBSYSTEM_COUNT;
+        long long allocations = total ? totalAllocations : snapshot.allocations[s];
+        long long bytes = total ? totalBytes : snapshot.bytes[s];
+        totalAllocations += allocations;
+        totalBytes += bytes;
+
+        out << left << setw(12) << (total ? "total" : ALLOC_SUBSYSTEM_NAMES[s]) << right << setw(14) << allocations << setw(16) << bytes;
+        if (hands > 0) {
+            out << setw(14) << static_cast<double>(allocations) / hands << setw(14) << static_cast<double>(bytes) / hands;
+        }
+        if (decisions > 0) {
+            out << setw(16) << static_cast<double>(allocations) / decisions;
+        }
+        if (batches > 0) {
+            out << setw(14) << ((total || s == ALLOC_TRAIN) ? static_cast<double>(allocations) / batches : 0);
+        }
+        out << endl;
+
+    }
+
+    out << "Allocations inside the guarded loop: " << snapshot.guarded;
+    if (snapshot.firstGuarded != -1) {
+        out << " (first in " << ALLOC_SUBSYSTEM_NAMES[snapshot.firstGuarded] << ")";
+    }
+    out << endl;
+
+}
+
+#endif
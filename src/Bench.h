@@ -0,0 +1,359 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: small benchmark harness with warmup, repetitions, allocation counts and json results
+*/
+
+// file guards
+#ifndef BENCH_H
+#define BENCH_H
+
+// the harness counts allocations with its own new, which can't live next to the alloc tracker's
+#if defined(BJ_ALLOC_TRACKING) && BJ_ALLOC_TRACKING
+#error "the benchmark harness can't be built with BJ_ALLOC_TRACKING=1"
+#endif
+
+// imports
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+// namespace
+using std::string;
+using std::vector;
+using std::sqrt, std::ceil;
+using std::malloc, std::free;
+using std::bad_alloc;
+using std::sort;
+using std::ofstream;
+using std::cout, std::endl;
+using std::setw, std::left, std::right, std::fixed, std::setprecision;
+namespace chrono = std::chrono;
+
+// heap allocations made so far by the program
+// benchmarks run on one thread so a plain counter is enough
+long long benchAllocationCount = 0;
+
+// every new in a program that includes the harness goes through here to be counted
+// kept out of line so the compiler doesn't pair an inlined malloc with a delete
+__attribute__((noinline)) void* operator new(size_t size) {
+
+    benchAllocationCount ++;
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+
+    return memory;
+
+}
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+
+    free(memory);
+
+}
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept {
+
+    free(memory);
+
+}
+
+// keeps the compiler from throwing away a value a benchmark works out
+template <typename T>
+void doNotOptimize(const T& value) {
+
+    asm volatile("" : : "r,m"(value) : "memory");
+
+}
+
+// how long to warm up and how long and how many times to time each benchmark
+struct BenchConfig {
+
+    // seconds of warmup, also used to pick the iteration count
+    double warmupSeconds;
+
+    // seconds each timed repetition should take
+    double repetitionSeconds;
+
+    // timed repetitions
+    int repetitions;
+
+};
+
+// iteration count and timing controls handed to a benchmark body
+// set up work a body doesn't want timed goes between pauseTiming and resumeTiming,
+// pausing costs around a clock read so it is only for ops much longer than that
+class BenchState {
+
+    private:
+
+        // ops the body should run
+        long long iterations;
+
+        // time and allocations left out while paused
+        chrono::steady_clock::time_point pausedAt;
+        long long pausedAllocationStart;
+        double pausedNs;
+        long long pausedAllocations;
+
+    public:
+
+        // constructor
+        BenchState(long long iterations) {
+
+            this->iterations = iterations;
+            this->pausedAllocationStart = 0;
+            this->pausedNs = 0;
+            this->pausedAllocations = 0;
+
+        }
+
+        // ops to run
+        long long getIterations() const {
+            return this->iterations;
+        }
+
+        // stop counting time and allocations
+        void pauseTiming() {
+
+            this->pausedAllocationStart = benchAllocationCount;
+            this->pausedAt = chrono::steady_clock::now();
+
+        }
+
+        // start counting time and allocations again
+        void resumeTiming() {
+
+            this->pausedNs += chrono::duration<double, std::nano>(chrono::steady_clock::now() - this->pausedAt).count();
+            this->pausedAllocations += benchAllocationCount - this->pausedAllocationStart;
+
+        }
+
+        // time and allocations left out
+        double getPausedNs() const {
+            return this->pausedNs;
+        }
+        long long getPausedAllocations() const {
+            return this->pausedAllocations;
+        }
+
+};
+
+// timing of one benchmark
+struct BenchResult {
+
+    // benchmark name and what it counts as an item (hands, cards, ...)
+    string name;
+    string itemName;
+
+    // items handled by one op
+    double itemsPerOp;
+
+    // ops per repetition and timed repetitions
+    long long iterations;
+    int repetitions;
+
+    // ns per op over the repetitions
+    double medianNs;
+    double minNs;
+    double meanNs;
+    double sdNs;
+
+    // ns per op of every repetition, fastest first
+    vector<double> repetitionNs;
+
+    // heap allocations per op
+    double allocationsPerOp;
+
+    // items per second at the median time
+    double itemsPerSecond;
+
+};
+
+// median, spread and rates of a benchmark's timed repetitions
+BenchResult summarizeBench(const string& name, const string& itemName, double itemsPerOp, long long iterations, vector<double> nsPerOp, long long totalAllocations) {
+
+    BenchResult result;
+    result.name = name;
+    result.itemName = itemName;
+    result.itemsPerOp = itemsPerOp;
+    result.iterations = iterations;
+    result.repetitions = nsPerOp.size();
+    result.allocationsPerOp = static_cast<double>(totalAllocations) / (static_cast<double>(iterations) * nsPerOp.size());
+
+    double sum = 0;
+    for (double x : nsPerOp) {
+        sum += x;
+    }
+    result.meanNs = sum / nsPerOp.size();
+    double squares = 0;
+    for (double x : nsPerOp) {
+        squares += (x - result.meanNs) * (x - result.meanNs);
+    }
+    result.sdNs = (nsPerOp.size() > 1) ? sqrt(squares / (nsPerOp.size() - 1)) : 0;
+
+    sort(nsPerOp.begin(), nsPerOp.end());
+    result.repetitionNs = nsPerOp;
+    result.minNs = nsPerOp.front();
+    int middle = nsPerOp.size() / 2;
+    result.medianNs = (nsPerOp.size() % 2 == 1) ? nsPerOp.at(middle) : (nsPerOp.at(middle - 1) + nsPerOp.at(middle)) / 2;
+    result.itemsPerSecond = (result.medianNs > 0) ? itemsPerOp * 1e9 / result.medianNs : 0;
+
+    return result;
+
+}
+
+// runs a body once for a number of ops
+// returns timed ns and allocations, leaving out paused parts
+template <typename Body>
+void runBenchBody(Body& body, long long iterations, double& ns, long long& allocations) {
+
+    BenchState state(iterations);
+    long long allocationStart = benchAllocationCount;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    body(state);
+
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    allocations = benchAllocationCount - allocationStart - state.getPausedAllocations();
+    ns = chrono::duration<double, std::nano>(end - start).count() - state.getPausedNs();
+
+}
+
+// times a benchmark body
+// the body runs state.getIterations() ops, e.g. for (long long i = 0; i < state.getIterations(); i ++)
+// warmup doubles the ops until the warmup time runs out, then the ops are set so each
+// repetition takes about the repetition time, and the median repetition is reported
+template <typename Body>
+BenchResult runBenchmark(const string& name, const BenchConfig& config, const string& itemName, double itemsPerOp, Body body) {
+
+    double ns;
+    long long allocations;
+
+    // warmup and iteration count
+    long long iterations = 1;
+    double warmupNs = 0;
+    double lastNs = 0;
+    long long lastIterations = 1;
+    while (warmupNs < config.warmupSeconds * 1e9) {
+
+        runBenchBody(body, iterations, ns, allocations);
+        warmupNs += ns;
+        lastNs = ns;
+        lastIterations = iterations;
+        iterations *= 2;
+
+    }
+    iterations = (lastNs > 0) ? ceil(lastIterations * config.repetitionSeconds * 1e9 / lastNs) : lastIterations;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    // timed repetitions
+    vector<double> nsPerOp;
+    long long totalAllocations = 0;
+    for (int r = 0; r < config.repetitions; r ++) {
+
+        runBenchBody(body, iterations, ns, allocations);
+        nsPerOp.push_back(ns / iterations);
+        totalAllocations += allocations;
+
+    }
+
+    return summarizeBench(name, itemName, itemsPerOp, iterations, nsPerOp, totalAllocations);
+
+}
+
+// times a body that does a fixed amount of work, like a whole training run
+// the body runs once untimed to warm up, then once per repetition as a single op
+template <typename Body>
+BenchResult runFixedBenchmark(const string& name, int repetitions, const string& itemName, double itemsPerOp, Body body) {
+
+    double ns;
+    long long allocations;
+
+    // warmup
+    runBenchBody(body, 1, ns, allocations);
+
+    // timed repetitions
+    vector<double> nsPerOp;
+    long long totalAllocations = 0;
+    for (int r = 0; r < repetitions; r ++) {
+
+        runBenchBody(body, 1, ns, allocations);
+        nsPerOp.push_back(ns);
+        totalAllocations += allocations;
+
+    }
+
+    return summarizeBench(name, itemName, itemsPerOp, 1, nsPerOp, totalAllocations);
+
+}
+
+// prints a results table
+void printBenchResults(const vector<BenchResult>& results) {
+
+    cout << left << setw(32) << "benchmark" << right << setw(14) << "ns/op" << setw(10) << "sd %" << setw(12) << "allocs/op" << setw(16) << "items/sec" << "  item" << endl;
+    for (const BenchResult& result : results) {
+
+        double sdPercent = (result.meanNs > 0) ? 100 * result.sdNs / result.meanNs : 0;
+        cout << left << setw(32) << result.name << right << fixed;
+        cout << setw(14) << setprecision(1) << result.medianNs;
+        cout << setw(10) << setprecision(2) << sdPercent;
+        cout << setw(12) << setprecision(2) << result.allocationsPerOp;
+        cout << setw(16) << setprecision(0) << result.itemsPerSecond;
+        cout << "  " << result.itemName << endl;
+
+    }
+
+}
+
+// writes results as json so runs can be compared over time
+bool writeBenchJson(const string& path, const string& label, const BenchConfig& config, const vector<BenchResult>& results) {
+
+    ofstream outfile(path);
+    outfile << setprecision(6);
+
+    outfile << "{" << endl;
+    outfile << "  \"label\": \"" << label << "\"," << endl;
+    outfile << "  \"compiler\": \"" << __VERSION__ << "\"," << endl;
+#ifdef __OPTIMIZE__
+    outfile << "  \"optimized\": true," << endl;
+#else
+    outfile << "  \"optimized\": false," << endl;
+#endif
+    outfile << "  \"warmup_seconds\": " << config.warmupSeconds << "," << endl;
+    outfile << "  \"repetition_seconds\": " << config.repetitionSeconds << "," << endl;
+    outfile << "  \"repetitions\": " << config.repetitions << "," << endl;
+    outfile << "  \"benchmarks\": [" << endl;
+    for (unsigned int b = 0; b < results.size(); b ++) {
+
+        const BenchResult& result = results.at(b);
+        outfile << "    {\"name\": \"" << result.name << "\"";
+        outfile << ", \"iterations\": " << result.iterations;
+        outfile << ", \"ns_per_op\": " << result.medianNs;
+        outfile << ", \"min_ns_per_op\": " << result.minNs;
+        outfile << ", \"mean_ns_per_op\": " << result.meanNs;
+        outfile << ", \"sd_ns_per_op\": " << result.sdNs;
+        outfile << ", \"allocations_per_op\": " << result.allocationsPerOp;
+        outfile << ", \"item\": \"" << result.itemName << "\"";
+        outfile << ", \"items_per_op\": " << result.itemsPerOp;
+        outfile << ", \"items_per_second\": " << result.itemsPerSecond << "}";
+        outfile << ((b + 1 < results.size()) ? "," : "") << endl;
+
+    }
+    outfile << "  ]" << endl;
+    outfile << "}" << endl;
+
+    return outfile.good();
+
+}
+
+#endif
@@ -0,0 +1,339 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: betting strategies and bankroll tracks that follow many strategies over the same hands
+*/
+
+// file guards
+#ifndef BETTING_H
+#define BETTING_H
+
+// imports
+#include <string>
+#include <vector>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+// namespace
+using std::string;
+using std::vector;
+using std::stringstream;
+using std::getline;
+using std::log, std::exp, std::pow, std::floor;
+using std::atof, std::atoi;
+using std::min;
+
+// kinds of betting strategies
+// constant bets M every game
+// interval bets P of the free cash above the current interval, at least M (see Betting_Function.txt)
+enum BettingType {CONSTANT_BETTING, INTERVAL_BETTING};
+
+// betting strategy parameters
+struct BettingStrategy {
+
+    // kind of strategy
+    BettingType type;
+
+    // percent of current free cash to bet
+    double p;
+
+    // amount to bet when in-between intervals, and the smallest bet
+    double m;
+
+    // the minimum betting interval
+    int imin;
+
+    // the speed at which the betting intervals grow
+    int ispeed;
+
+    // the size by which the betting intervals grow
+    int isize;
+
+};
+
+// name of a strategy for results
+string bettingLabel(const BettingStrategy& strategy) {
+
+    stringstream label;
+    if (strategy.type == CONSTANT_BETTING) {
+        label << "const M=" << strategy.m;
+    }
+    else {
+        label << "interval P=" << strategy.p << " M=" << strategy.m << " I=" << strategy.imin << "/" << strategy.ispeed << "/" << strategy.isize;
+    }
+
+    return label.str();
+
+}
+
+// reads a strategy from const:M or interval:P:M:IMIN:ISPEED:ISIZE
+// returns false if it can't be read
+bool parseBettingStrategy(const string& spec, BettingStrategy& strategy) {
+
+    // split fields
+    vector<string> fields;
+    stringstream specStream(spec);
+    string field;
+    while (getline(specStream, field, ':')) {
+        fields.push_back(field);
+    }
+
+    if (fields.size() == 2 && fields.at(0) == "const") {
+
+        strategy = {CONSTANT_BETTING, 0, atof(fields.at(1).c_str()), 0, 0, 0};
+        return strategy.m > 0;
+
+    }
+    if (fields.size() == 6 && fields.at(0) == "interval") {
+
+        strategy = {
+            INTERVAL_BETTING,
+            atof(fields.at(1).c_str()),
+            atof(fields.at(2).c_str()),
+            atoi(fields.at(3).c_str()),
+            atoi(fields.at(4).c_str()),
+            atoi(fields.at(5).c_str())
+        };
+        return strategy.m > 0 && strategy.imin > 0 && strategy.ispeed > 1 && strategy.isize > 1;
+
+    }
+
+    return false;
+
+}
+
+// reads a ; separated list of strategies
+// returns false if one can't be read
+bool parseBettingStrategies(const string& specs, vector<BettingStrategy>& strategies) {
+
+    stringstream specStream(specs);
+    string spec;
+    BettingStrategy strategy;
+    while (getline(specStream, spec, ';')) {
+
+        if (!parseBettingStrategy(spec, strategy)) {
+            return false;
+        }
+        strategies.push_back(strategy);
+
+    }
+
+    return true;
+
+}
+
+// grid of interval strategies around the eval defaults, plus constant bets
+vector<BettingStrategy> bettingGrid() {
+
+    const double GRID_P[] = {0.02, 0.04, 0.08, 0.16, 0.32};
+    const double GRID_M[] = {1, 2, 5};
+    const int GRID_IMIN[] = {50, 100, 200};
+    const int GRID_ISIZE[] = {2, 10};
+
+    vector<BettingStrategy> strategies;
+    for (double m : GRID_M) {
+
+        strategies.push_back({CONSTANT_BETTING, 0, m, 0, 0, 0});
+        for (double p : GRID_P) {
+            for (int imin : GRID_IMIN) {
+                for (int isize : GRID_ISIZE) {
+                    strategies.push_back({INTERVAL_BETTING, p, m, imin, 10, isize});
+                }
+            }
+        }
+
+    }
+
+    return strategies;
+
+}
+
+// bankrolls for many strategies playing the same hands
+// kept as arrays per field so settling a hand is one straight loop over every track
+class BankrollTracks {
+
+    private:
+
+        // number of tracks
+        int trackCount;
+
+        // current balances and bets
+        vector<double> balances;
+        vector<double> bets;
+
+        // strategy fields
+        vector<double> p;
+        vector<double> m;
+        vector<double> imin;
+        vector<double> logSpeed;
+        vector<double> isize;
+        vector<char> interval;
+
+        // current interval of each track and the balances it holds for,
+        // only worked out again once the balance leaves that range
+        vector<double> currentInterval;
+        vector<double> rangeLow;
+        vector<double> rangeHigh;
+
+        // tracks that went broke this round and the game they went broke on
+        vector<char> broke;
+        vector<int> ruinGames;
+
+        // highest balance and largest drop from it this round
+        vector<double> peaks;
+        vector<double> drawdowns;
+
+    public:
+
+        // constructor
+        BankrollTracks(const vector<BettingStrategy>& strategies) {
+
+            this->trackCount = strategies.size();
+            this->balances = vector<double>(this->trackCount, 0);
+            this->bets = vector<double>(this->trackCount, 0);
+            this->broke = vector<char>(this->trackCount, 0);
+            this->ruinGames = vector<int>(this->trackCount, -1);
+            this->peaks = vector<double>(this->trackCount, 0);
+            this->drawdowns = vector<double>(this->trackCount, 0);
+            this->currentInterval = vector<double>(this->trackCount, 0);
+            this->rangeLow = vector<double>(this->trackCount, 0);
+            this->rangeHigh = vector<double>(this->trackCount, 0);
+
+            for (int k = 0; k < this->trackCount; k ++) {
+
+                const BettingStrategy& strategy = strategies.at(k);
+                this->p.push_back(strategy.p);
+                this->m.push_back(strategy.m);
+                this->imin.push_back(strategy.imin);
+                this->logSpeed.push_back(strategy.type == INTERVAL_BETTING ? log(strategy.ispeed) : 1);
+                this->isize.push_back(strategy.isize);
+                this->interval.push_back(strategy.type == INTERVAL_BETTING);
+
+            }
+
+        }
+
+        // set every balance to the starting balance
+        void startRound(double startingBal) {
+
+            for (int k = 0; k < this->trackCount; k ++) {
+
+                this->balances[k] = startingBal;
+                this->broke[k] = 0;
+                this->ruinGames[k] = -1;
+                this->peaks[k] = startingBal;
+                this->drawdowns[k] = 0;
+
+            }
+
+        }
+
+        // set each track's bet for the next hand, scaled by a number of bet units
+        // a track is broke once it can't cover its smallest bet m, a scaled bet bigger than the
+        // balance is cut to the balance so the track stakes what it has rather than going negative
+        // tracks that can't bet are broke for the rest of the round with a zero balance and bet
+        // game number is kept as the ruin time of tracks that go broke
+        // returns false once every track is broke
+        bool placeBets(int gameNum, double units) {
+
+            bool anyBetting = false;
+            for (int k = 0; k < this->trackCount; k ++) {
+
+                // break if broke
+                if (this->broke[k] || this->balances[k] < this->m[k]) {
+
+                    if (!this->broke[k]) {
+                        this->ruinGames[k] = gameNum;
+                    }
+                    this->broke[k] = 1;
+                    this->balances[k] = 0;
+                    this->bets[k] = 0;
+                    continue;
+
+                }
+                anyBetting = true;
+
+                // constant bet
+                if (!this->interval[k]) {
+
+                    this->bets[k] = min(this->m[k] * units, this->balances[k]);
+                    continue;
+
+                }
+
+                // interval is isize to the floored log of the balance, at least imin
+                double bal = this->balances[k];
+                if (bal < this->rangeLow[k] || bal >= this->rangeHigh[k]) {
+
+                    double power = floor(log(bal) / this->logSpeed[k]);
+                    double i = pow(this->isize[k], power);
+                    this->currentInterval[k] = (i < this->imin[k]) ? this->imin[k] : i;
+                    this->rangeLow[k] = exp(power * this->logSpeed[k]);
+                    this->rangeHigh[k] = exp((power + 1) * this->logSpeed[k]);
+
+                }
+                double i = this->currentInterval[k];
+
+                // bet the share of the free cash above the interval, at least m
+                double bet = (bal - i * floor(bal / i)) * this->p[k];
+                this->bets[k] = min(((bet <= this->m[k]) ? this->m[k] : bet) * units, bal);
+
+            }
+
+            return anyBetting;
+
+        }
+
+        // pay out a hand's balance change in bets to every track
+        // and move each track's peak and drawdown along
+        void settle(double change) {
+
+            double* balances = this->balances.data();
+            double* peaks = this->peaks.data();
+            double* drawdowns = this->drawdowns.data();
+            const double* bets = this->bets.data();
+            for (int k = 0; k < this->trackCount; k ++) {
+
+                balances[k] += bets[k] * change;
+                peaks[k] = (balances[k] > peaks[k]) ? balances[k] : peaks[k];
+                drawdowns[k] = (peaks[k] - balances[k] > drawdowns[k]) ? peaks[k] - balances[k] : drawdowns[k];
+
+            }
+
+        }
+
+        // balance of a track
+        double getBalance(int k) const {
+            return this->balances[k];
+        }
+
+        // true if a track went broke this round
+        bool isBroke(int k) const {
+            return this->broke[k];
+        }
+
+        // game a track went broke on, -1 if it didn't
+        int getRuinGame(int k) const {
+            return this->ruinGames[k];
+        }
+
+        // highest balance of a track this round
+        double getPeak(int k) const {
+            return this->peaks[k];
+        }
+
+        // largest drop from a peak this round
+        double getDrawdown(int k) const {
+            return this->drawdowns[k];
+        }
+
+        // number of tracks
+        int size() const {
+            return this->trackCount;
+        }
+
+};
+
+#endif
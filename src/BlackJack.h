@@ -13,6 +13,9 @@
 #include <ctime>
 #include <random>
 #include <algorithm>
+#include "Counters.h"
+#include "Trace.h"
+#include "AllocTracker.h"
 
 #include <iostream>
 using std::cout, std::endl;
@@ -21,7 +24,7 @@ using std::cout, std::endl;
 using std::vector;
 using std::time;
 using std::mt19937;
-using std::shuffle;
+using std::shuffle, std::reverse;
 
 // constants
 const int CARDS_PER_DECK = 52;
@@ -30,6 +33,13 @@ const int CARD_SUITS = 4;
 const int CARD_TYPES[CARD_TYPE_COUNT] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10};
 const int DEALER_STAND = 17;
 
+// most cards a player hand can hold, every card at least 1 and the last one busting
+const int MAX_HAND_CARDS = 22;
+
+// hi-lo count value of each card by numeric value, index 0 unused
+// 2-6 count +1, 7-9 count 0, tens and aces count -1
+const int HI_LO_VALUES[11] = {0, -1, 1, 1, 1, 1, 1, 0, 0, 0, -1};
+
 // scoring struct
 struct Scoring {
 
@@ -78,9 +88,15 @@ class Dealer {
         // number of cards delt
         int cardDeltCount;
 
+        // hi-lo running count of the cards delt since the last shuffle
+        int runningCount;
+
         // randomizer for shuffle
         mt19937 randomizer;
 
+        // every card dealt is added here when set, for hand traces
+        vector<unsigned char>* tape = nullptr;
+
     public:
 
         // default constructor
@@ -119,11 +135,32 @@ class Dealer {
 
         }
 
+        // constructor with a fixed shuffle seed
+        Dealer(int deckCount, int beforeShuffle, unsigned int seed) {
+
+            // set decks
+            this->fullDeckCount = deckCount;
+            this->decksBeforeShuffle = beforeShuffle;
+
+            // start cards delt at 0
+            this->cardDeltCount = 0;
+
+            // seed random function
+            this->randomizer = mt19937(seed);
+
+            // setup deck
+            this->reshuffle();
+
+        }
+
         // regathers and shuffles the deck
         void reshuffle() {
 
-            // empty out deck
-            vector<int>().swap(this->deck);
+            BJ_TRACE_ZONE("reshuffle");
+            BJ_ALLOC_SCOPE(ALLOC_SHOE);
+
+            // empty out deck, keeping its memory for the refill
+            this->deck.clear();
             
             // populate deck
             // iterate through card types 
@@ -142,14 +179,44 @@ class Dealer {
 
             // run shuffle
             shuffle(this->deck.begin(), this->deck.end(), this->randomizer);
+            BJ_COUNT(RESHUFFLES);
 
             // start cards delt at 0
             this->cardDeltCount = 0;
+            this->runningCount = 0;
+
+        }
+
+        // hi-lo running count
+        int getRunningCount() const {
+            return this->runningCount;
+        }
+
+        // running count per deck left in the shoe
+        double getTrueCount() const {
+            return this->runningCount * static_cast<double>(CARDS_PER_DECK) / this->deck.size();
+        }
+
+        // records every card dealt from now on to a tape, nullptr stops recording
+        void setTape(vector<unsigned char>* tape) {
+            this->tape = tape;
+        }
+
+        // replaces the shoe with cards to deal in order, for replaying a recorded hand
+        // the dealer should be set to deal all of them before reshuffling
+        void loadShoe(const unsigned char* cards, int cardCount) {
+
+            this->deck.assign(cards, cards + cardCount);
+            reverse(this->deck.begin(), this->deck.end());
+            this->cardDeltCount = 0;
+            this->runningCount = 0;
 
         }
 
         // pops a card
         int deal() {
+
+            BJ_ALLOC_SCOPE(ALLOC_SHOE);
             
             // grab card
             // cout << deck.size() << endl;
@@ -158,6 +225,11 @@ class Dealer {
             // deal card
             this->deck.pop_back();
             this->cardDeltCount ++;
+            this->runningCount += HI_LO_VALUES[card];
+            BJ_COUNT(CARDS_DEALT);
+            if (this->tape) {
+                this->tape->push_back(card);
+            }
 
             // check for reshuffle if cards delt is deck amount
             if (cardDeltCount >= decksBeforeShuffle * CARDS_PER_DECK) {
@@ -188,6 +260,9 @@ class Game {
         // player doubled
         bool doubleGame;
 
+        // splits made since the hand was dealt, across all its split branches
+        int splitDepth;
+
         // game is over
         bool gameOver;
 
@@ -211,12 +286,14 @@ class Game {
             // default construct deck
             this->dealer = nullptr;
 
-            // set hands to empty
+            // set hands to empty, with room for the biggest possible hand
             this->table = {0, vector<int>(), 0, 0};
+            this->table.playerCards.reserve(MAX_HAND_CARDS);
             this->dealerSecondCard = 0;
 
             // set bet
             this->doubleGame = false;
+            this->splitDepth = 0;
 
             // set game conclusion bools to false
             this->gameOver = false;
@@ -235,12 +312,14 @@ class Game {
             // init dealer with args
             this->dealer = dealer;
 
-            // set hands to empty
+            // set hands to empty, with room for the biggest possible hand
             this->table = {0, vector<int>(), 0, 0};
+            this->table.playerCards.reserve(MAX_HAND_CARDS);
             this->dealerSecondCard = 0;
 
             // set bet
             this->doubleGame = false;
+            this->splitDepth = 0;
 
             // set game conclusion bools to false
             this->gameOver = false;
@@ -255,10 +334,15 @@ class Game {
         // setup the game to play first half of split
         void runSplit() {
 
+            BJ_ALLOC_SCOPE(ALLOC_GAME);
+
             // remove second card
             this->table.playerCards.pop_back();
             this->table.playerSum = this->table.playerCards.at(0);
             this->table.playerAces = (this->table.playerCards.at(0) == 1) ? 1 : 0;
+            this->splitDepth ++;
+            BJ_COUNT(SPLITS);
+            BJ_COUNT_SPLIT_DEPTH(this->splitDepth);
 
             // add new second card
             this->hit();
@@ -268,8 +352,14 @@ class Game {
         // split setup to play 2nd half
         void setupSplit(int playerCard, int dealerCard1, int dealerCard2) {
 
-            // set hands to have cards from split game
-            this->table = {dealerCard1, vector<int>({playerCard}), (playerCard == 1) ? 1 : 0, playerCard};
+            BJ_ALLOC_SCOPE(ALLOC_GAME);
+
+            // set hands to have cards from split game, reusing the card list
+            this->table.dealerShowing = dealerCard1;
+            this->table.playerCards.clear();
+            this->table.playerCards.push_back(playerCard);
+            this->table.playerAces = (playerCard == 1) ? 1 : 0;
+            this->table.playerSum = playerCard;
             this->dealerSecondCard = dealerCard2;
 
             // set bet
@@ -287,6 +377,8 @@ class Game {
         // returns game over flag
         bool dealHands() {
 
+            BJ_ALLOC_SCOPE(ALLOC_GAME);
+
             // deal all cards
             // add to sums
             // check for aces
@@ -311,10 +403,59 @@ class Game {
             this->table.dealerShowing = this->dealer->deal();
             
             this->dealerSecondCard = this->dealer->deal();
+            this->splitDepth = 0;
+            BJ_COUNT(HANDS_DEALT);
+
+            return this->checkNaturals();
+
+        }
+
+        // deal a chosen starting state for exploring starts
+        // player cards and the dealer upcard are given, the hole card comes from the shoe
+        // returns game over flag
+        bool dealStartingHands(const vector<int>& playerCards, int dealerShowing) {
+
+            BJ_ALLOC_SCOPE(ALLOC_GAME);
+
+            // set player cards
+            this->table.playerCards = playerCards;
+            this->table.playerSum = 0;
+            this->table.playerAces = 0;
+
+            // add to sum and check for aces
+            for (unsigned int i = 0; i < playerCards.size(); i ++) {
+
+                this->table.playerSum += playerCards.at(i);
+
+                if (playerCards.at(i) == 1) {
+                    this->table.playerAces ++;
+                }
+
+            }
+
+            // set dealer cards
+            this->table.dealerShowing = dealerShowing;
+            this->dealerSecondCard = this->dealer->deal();
+            this->splitDepth = 0;
+            BJ_COUNT(HANDS_DEALT);
+
+            return this->checkNaturals();
+
+        }
+
+        // check a freshly dealt table for blackjacks
+        // returns game over flag
+        bool checkNaturals() {
 
             // check for blackjacks
-            bool player21 = this->table.playerSum == 11;
+            bool player21 = this->table.playerCards.size() == 2 && this->table.playerSum == 11;
             bool dealer21 = (this->table.dealerShowing == 10 && this->dealerSecondCard == 1) || (this->table.dealerShowing == 1 && this->dealerSecondCard == 10);
+            if (player21) {
+                BJ_COUNT(PLAYER_NATURALS);
+            }
+            if (dealer21) {
+                BJ_COUNT(DEALER_NATURALS);
+            }
 
             // check for player blackjack
             if (player21 && !dealer21) {
@@ -354,6 +495,8 @@ class Game {
         // take hit for player
         bool hit() {
 
+            BJ_ALLOC_SCOPE(ALLOC_GAME);
+
             // update state
             this->table.playerCards.push_back(this->dealer->deal());
 
@@ -370,6 +513,8 @@ class Game {
             // check for bust
             if (this->table.playerSum > 21) {
 
+                BJ_COUNT(PLAYER_BUSTS);
+
                 // set loss
                 this->gameOver = true;
                 this->playerWon = false;
@@ -385,6 +530,8 @@ class Game {
         // play out dealer hits
         void playDealer() {
 
+            BJ_ALLOC_SCOPE(ALLOC_GAME);
+
             // make sure game isn't over
             if (this->gameOver) {
                 return;
@@ -402,10 +549,12 @@ class Game {
             bool dealerBusted = (dealerSum > 21);
 
             // keep hitting while too low to stand and didn't bust
+            BJ_COUNT(DEALER_HANDS_PLAYED);
             while (!dealerWillStand && !dealerBusted) {
 
                 // get hit for dealer
                 dealerHit = this->dealer->deal();
+                BJ_COUNT(DEALER_DRAWS);
 
                 // update sum and ace
                 dealerSum += dealerHit;
@@ -428,6 +577,9 @@ class Game {
             this->table.playerSum = ((this->table.playerSum + 10) <= 21 && this->table.playerAces) ? (this->table.playerSum + 10) : this->table.playerSum;
 
             // check for player win 
+            if (dealerBusted) {
+                BJ_COUNT(DEALER_BUSTS);
+            }
             if (dealerBusted || dealerSum < this->table.playerSum) {
 
                 // set win
@@ -463,8 +615,11 @@ class Game {
         // reset game so that it is ready for a new one
         void reset() {
 
-            // set hands to empty
-            this->table = {0, vector<int>(), 0, 0};
+            // set hands to empty, keeping the card list's memory
+            this->table.dealerShowing = 0;
+            this->table.playerCards.clear();
+            this->table.playerAces = 0;
+            this->table.playerSum = 0;
             this->dealerSecondCard = 0;
 
             // set bet
@@ -479,7 +634,7 @@ class Game {
         }
 
         // state accessor
-        Hands getState() const {
+        const Hands& getState() const {
 
             return this->table;
         }
@@ -513,6 +668,7 @@ class Game {
         void doubleBet() {
 
             this->doubleGame = true;
+            BJ_COUNT(DOUBLES);
         }
 
 };
@@ -17,7 +17,12 @@
 #include <cstdlib>
 #include <ctime>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cassert>
 #include "BlackJack.h"
+#include "ReplayBuffer.h"
+#include "Trace.h"
 
 // namespace
 using std::string;
@@ -25,7 +30,9 @@ using std::ofstream, std::ifstream;
 using std::vector, std::pair;
 using std::function;
 using std::srand, std::time;
-using std::max_element;
+using std::max_element, std::max;
+using std::sqrt, std::erfc, std::pow, std::fabs;
+using std::numeric_limits;
 
 // hand possibility count
 const int PLAYER_HAND_COUNT = 36;
@@ -83,6 +90,12 @@ const string PLAYER_HANDS[PLAYER_HAND_COUNT] = {
 const int TABLE_FIRST_ACE_INDEX = 17;
 const int TABLE_FIRST_PAIR_INDEX = 26;
 
+// normal quantile for the 95% confidence intervals on returns
+const double CI_Z = 1.96;
+
+// smallest sampling weight given to a settled cell
+const double SETTLED_CELL_WEIGHT = 0.01;
+
 // list of all the possible dealer hands (1 card showing)
 // labels for columns on the q table
 const string DEALER_HANDS[DEALER_HAND_COUNT] = {
@@ -126,16 +139,62 @@ const string ACTION_NAMES[] = {
 
 };
 
-// action for history
-struct Action {
+// step size schedules for q updates
+// n is the number of updates the q value has had, including this one
+enum AlphaSchedule {
+
+    // alpha
+    CONSTANT_ALPHA,
+
+    // 1 / n, a running average of targets
+    SAMPLE_AVERAGE_ALPHA,
 
-    // state before action was taken
-    Hands state;
+    // 1 / n^power
+    POLYNOMIAL_ALPHA,
 
-    // action type taken
-    ActionType type;
+    // max(alpha, 1 / n), averages early then settles at alpha
+    CLAMPED_ALPHA
 
 };
+const int ALPHA_SCHEDULE_COUNT = 4;
+const string ALPHA_SCHEDULE_NAMES[ALPHA_SCHEDULE_COUNT] = {
+
+    "constant",
+    "average",
+    "polynomial",
+    "clamped"
+
+};
+
+// targets for q updates, all built from the same episode
+enum UpdateTarget {
+
+    // one step backup, reward or discounted best next q
+    ONE_STEP_Q,
+
+    // every visit monte carlo, the discounted game reward
+    MONTE_CARLO,
+
+    // lambda return mixing the two, lambda 0 is one step and 1 is monte carlo
+    TD_LAMBDA
+
+};
+const int UPDATE_TARGET_COUNT = 3;
+const string UPDATE_TARGET_NAMES[UPDATE_TARGET_COUNT] = {
+
+    "q",
+    "mc",
+    "lambda"
+
+};
+
+// room kept for the actions of each game in a training batch
+// games average under 2 actions, so batches almost never need more
+const int RESERVED_STEPS_PER_GAME = 4;
+
+// room kept for a game's actions and for the histories saved at its splits
+const int RESERVED_GAME_STEPS = 32;
+const int RESERVED_SPLIT_STEPS = 64;
 
 // struct to hold info on splits
 struct SplitInfo {
@@ -145,14 +204,15 @@ struct SplitInfo {
     int dealerCard1;
     int dealerCard2;
 
-    // action history for agent
-    vector<Action> actionHistory;
+    // agent action history at the split, as a slice of the agent's saved split histories
+    int historyStart;
+    int historyLength;
 
 };
 
 // converts a state struct to an index pair for q table
 // return format is pair<row/player_hand, col/dealer_hand>
-pair<int, int> getTableIndex(Hands state) {
+pair<int, int> getTableIndex(const Hands& state) {
 
     // return index pair
     pair<int, int> indexPair;
@@ -202,28 +262,176 @@ bool handIdxCanSplit(int index) {
 }
 
 // returns true if a state can split
-bool splitPossible(Hands state) {
+bool splitPossible(const Hands& state) {
 
     return state.playerCards.size() == 2 && state.playerCards.at(0) == state.playerCards.at(1);
 }
 
+// adds every hand of a card count that lands on a chart row
+// helper for findRowHands, cards are added in increasing order
+void addRowHands(vector<vector<int>> rowHands[PLAYER_HAND_COUNT], vector<int>& cards, int cardCount, int lowestCard) {
+
+    // hand is full
+    if (static_cast<int>(cards.size()) == cardCount) {
+
+        // build state for the hand
+        Hands state = {1, cards, 0, 0};
+        for (unsigned int i = 0; i < cards.size(); i ++) {
+
+            state.playerSum += cards.at(i);
+            state.playerAces += (cards.at(i) == 1) ? 1 : 0;
+
+        }
+
+        // skip busts and anything the game would pay as a blackjack
+        if (state.playerSum > 21 || (cards.size() == 2 && state.playerSum == 11)) {
+            return;
+        }
+
+        // skip totals below the chart
+        int row = getTableIndex(state).first;
+        if (row < 0) {
+            return;
+        }
+
+        // only keep hands with the fewest cards for a row
+        if (rowHands[row].size() > 0 && static_cast<int>(rowHands[row].at(0).size()) < cardCount) {
+            return;
+        }
+
+        rowHands[row].push_back(cards);
+        return;
+
+    }
+
+    // add next card in increasing order
+    for (int card = lowestCard; card <= DEALER_HAND_COUNT; card ++) {
+
+        cards.push_back(card);
+        addRowHands(rowHands, cards, cardCount, card);
+        cards.pop_back();
+
+    }
+
+}
+
+// finds the hands with the fewest cards that land on each chart row
+// two card hands first, then three cards for rows two can't reach
+// the game's blackjack check (any two cards summing to 11) is never included
+void findRowHands(vector<vector<int>> rowHands[PLAYER_HAND_COUNT]) {
+
+    vector<int> cards;
+    for (int cardCount = 2; cardCount <= 3; cardCount ++) {
+
+        addRowHands(rowHands, cards, cardCount, 1);
+
+    }
+
+}
+
+// the actions a player is allowed to take in a state as a bit per ActionType
+// stand on hard 21, double on the first two cards, split on pairs
+unsigned char legalActionMask(const Hands& state) {
+
+    // always allowed to stand
+    unsigned char legal = 1 << STAND;
+
+    // nothing else on hard 21
+    if (state.playerSum == 21) {
+        return legal;
+    }
+
+    // hit is always an option below 21
+    legal |= 1 << HIT;
+
+    // double only as the first move
+    if (state.playerCards.size() == 2) {
+        legal |= 1 << DOUBLE;
+    }
+
+    // split only on pairs
+    if (splitPossible(state)) {
+        legal |= 1 << SPLIT;
+    }
+
+    return legal;
+
+}
+
+// returns the actions a player is allowed to take in a state, in ActionType order
+// the list is read off legalActionMask so both follow the same rules
+vector<ActionType> legalActions(const Hands& state) {
+
+    // list of allowed actions
+    vector<ActionType> actions;
+
+    unsigned char legal = legalActionMask(state);
+    for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+
+        if (legal & (1 << k)) {
+            actions.push_back(static_cast<ActionType>(k));
+        }
+
+    }
+
+    return actions;
+
+}
+
+// removes an option from parallel lists of actions and their q values
+// later options move down one, the same as erasing from a vector
+void removeActionOption(ActionType actions[], double actionRatings[], int& optionCount, int index) {
+
+    for (int i = index; i < optionCount - 1; i ++) {
+
+        actions[i] = actions[i + 1];
+        actionRatings[i] = actionRatings[i + 1];
+
+    }
+    optionCount --;
+
+}
+
 // agent class
 class BlackJackAgent {
 
     private:
 
-        // list of actions taken
-        vector<Action> gameActions;
+        // actions of the game being played in q table coordinates
+        vector<EpisodeStep> gameActions;
 
-        // training example list
-        // it goes list[ game[gameActions[action], reward] ]
-        vector<pair<vector<Action>, double>> trainingExamples;
+        // action histories saved at splits, dropped when a new game is dealt
+        vector<EpisodeStep> splitHistory;
+
+        // training examples, kept flat so emptying them keeps their memory
+        // steps holds every game's actions back to back, games each game's action count and reward
+        vector<EpisodeStep> trainingSteps;
+        vector<pair<int, double>> trainingGames;
 
         // epsilon and gamma parameters
         function<double(int)> E_FUNC;
         double G;
         double A;
 
+        // step size schedule and its power for polynomial decay
+        AlphaSchedule alphaSchedule;
+        double alphaPower;
+
+        // update target and lambda for td(lambda)
+        UpdateTarget updateTarget;
+        double lambda;
+
+        // replay memory, null when replay is off
+        ReplayBuffer* replay;
+
+        // replayed games per new game, minibatch size and replays owed
+        double replayRatio;
+        int replayBatchSize;
+        double replayDebt;
+
+        // slots of the minibatch being replayed
+        vector<int> replayBatch;
+
         // Q table
         // table[player hand][dealer hand][action]
         // action dimension indexes correspond to enum int values
@@ -235,6 +443,12 @@ class BlackJackAgent {
         // total number of examples used
         int trainingCountTotal;
 
+        // running return statistics per q value (welford)
+        // count, mean and sum of squared differences from the mean
+        int returnCounts[PLAYER_HAND_COUNT][DEALER_HAND_COUNT][ACTION_TYPE_COUNT];
+        double returnMeans[PLAYER_HAND_COUNT][DEALER_HAND_COUNT][ACTION_TYPE_COUNT];
+        double returnM2[PLAYER_HAND_COUNT][DEALER_HAND_COUNT][ACTION_TYPE_COUNT];
+
     public:
 
         // default constructor
@@ -245,10 +459,22 @@ class BlackJackAgent {
             this->E_FUNC = [](int x) { return 0.0; };
             this->G = -1;
             this->A = 0;
+            this->alphaSchedule = CONSTANT_ALPHA;
+            this->alphaPower = 1;
+            this->updateTarget = ONE_STEP_Q;
+            this->lambda = 0;
+            this->replay = nullptr;
+            this->replayRatio = 0;
+            this->replayBatchSize = 0;
+            this->replayDebt = 0;
 
             // set count
             this->trainingCountTotal= 0;
 
+            // room for game and split histories
+            this->gameActions.reserve(RESERVED_GAME_STEPS);
+            this->splitHistory.reserve(RESERVED_SPLIT_STEPS);
+
             // populate table values and counts
             for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
                 for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
@@ -260,6 +486,11 @@ class BlackJackAgent {
                         // set training example counts
                         this->trainingCounts[i][j][k] = 0;
 
+                        // set return statistics
+                        this->returnCounts[i][j][k] = 0;
+                        this->returnMeans[i][j][k] = 0;
+                        this->returnM2[i][j][k] = 0;
+
                     }
                 }
             }
@@ -273,10 +504,22 @@ class BlackJackAgent {
             this->E_FUNC = epsilon;
             this->G = gamma;
             this->A = alpha;
+            this->alphaSchedule = CONSTANT_ALPHA;
+            this->alphaPower = 1;
+            this->updateTarget = ONE_STEP_Q;
+            this->lambda = 0;
+            this->replay = nullptr;
+            this->replayRatio = 0;
+            this->replayBatchSize = 0;
+            this->replayDebt = 0;
 
             // set count
             this->trainingCountTotal= 0;
 
+            // room for game and split histories
+            this->gameActions.reserve(RESERVED_GAME_STEPS);
+            this->splitHistory.reserve(RESERVED_SPLIT_STEPS);
+
             // populate table values and counts
             for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
                 for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
@@ -288,6 +531,11 @@ class BlackJackAgent {
                         // set training example counts
                         this->trainingCounts[i][j][k] = 0;
 
+                        // set return statistics
+                        this->returnCounts[i][j][k] = 0;
+                        this->returnMeans[i][j][k] = 0;
+                        this->returnM2[i][j][k] = 0;
+
                     }
                 }
             }
@@ -297,8 +545,17 @@ class BlackJackAgent {
 
         }
 
+        // destructor
+        ~BlackJackAgent() {
+
+            delete this->replay;
+
+        }
+
         // get agent choice
-        ActionType makeMove(Hands state) {
+        ActionType makeMove(const Hands& state) {
+
+            BJ_ALLOC_SCOPE(ALLOC_AGENT);
 
             // get q table coordinates
             pair<int, int> coords = getTableIndex(state);
@@ -312,15 +569,16 @@ class BlackJackAgent {
             // check if the player hasn't done any actions already
             bool firstAction = state.playerCards.size() == 2;
 
-            // parallel vectors of actions and their q values
-            vector<ActionType> actions;
-            vector<double> actionRatings;
+            // parallel lists of actions and their q values
+            ActionType actions[ACTION_TYPE_COUNT];
+            double actionRatings[ACTION_TYPE_COUNT];
+            int optionCount = ACTION_TYPE_COUNT;
 
             // copy q values to action ratings
             for (int i = 0; i < ACTION_TYPE_COUNT; i ++) {
 
-                actions.push_back(static_cast<ActionType>(i));
-                actionRatings.push_back(qTable[coords.first][coords.second][i]);
+                actions[i] = static_cast<ActionType>(i);
+                actionRatings[i] = qTable[coords.first][coords.second][i];
 
             }
 
@@ -328,32 +586,27 @@ class BlackJackAgent {
             if (has21) {
 
                 // remove hit option
-                actions.erase(actions.begin() + HIT);
-                actionRatings.erase(actionRatings.begin() + HIT);
+                removeActionOption(actions, actionRatings, optionCount, HIT);
 
                 // remove double option
-                actions.erase(actions.begin() + DOUBLE);
-                actionRatings.erase(actionRatings.begin() + DOUBLE);
+                removeActionOption(actions, actionRatings, optionCount, DOUBLE);
 
             }
             // remove split option if needed
             else if (!canSplit) {
 
                 // remove split option
-                actions.erase(actions.begin() + SPLIT);
-                actionRatings.erase(actionRatings.begin() + SPLIT);
+                removeActionOption(actions, actionRatings, optionCount, SPLIT);
 
             }
             // remove double and split if not first move
             else if (!firstAction) {
 
                 // remove split option
-                actions.erase(actions.begin() + SPLIT);
-                actionRatings.erase(actionRatings.begin() + SPLIT);
+                removeActionOption(actions, actionRatings, optionCount, SPLIT);
 
                 // remove double option
-                actions.erase(actions.begin() + DOUBLE);
-                actionRatings.erase(actionRatings.begin() + DOUBLE);
+                removeActionOption(actions, actionRatings, optionCount, DOUBLE);
 
             }
 
@@ -375,35 +628,33 @@ class BlackJackAgent {
 
             //cout << "about to calc index" << endl;
             // info on max q in action state
-            vector<double>::iterator maxQIterator = max_element(actionRatings.begin(), actionRatings.end());
-            int maxQIndex = maxQIterator - actionRatings.begin();
+            int maxQIndex = max_element(actionRatings, actionRatings + optionCount) - actionRatings;
             //cout << "index calced" << endl;
 
             // explore
             if (random < epsilon) {
 
                 // pick random option 
-                actionChosen = static_cast<ActionType>(rand() % actionRatings.size());
+                actionChosen = static_cast<ActionType>(rand() % optionCount);
+                BJ_COUNT(EXPLORE_DECISIONS);
 
             }
             // educated guess 
             else {
 
                 actionChosen = static_cast<ActionType>(maxQIndex);
+                BJ_COUNT(EXPLOIT_DECISIONS);
 
             }
 
             //cout << "action picked" << endl;
 
-            // create new move object
-            // set reward to 0 to be replaced later when needed
-            Action action = {
-                state,
-                actionChosen
-            };
-
-            // add action to history
-            this->gameActions.push_back(action);
+            // add action to history in table coordinates
+            this->gameActions.push_back({
+                static_cast<unsigned char>(coords.first),
+                static_cast<unsigned char>(coords.second),
+                static_cast<unsigned char>(actionChosen)
+            });
 
             //cout << "action pushed back" << endl;
 
@@ -412,126 +663,408 @@ class BlackJackAgent {
 
         }
 
+        // record an action chosen outside of the agent (exploring starts)
+        ActionType forceMove(const Hands& state, ActionType actionChosen) {
+
+            BJ_ALLOC_SCOPE(ALLOC_AGENT);
+
+            // add action to history in table coordinates
+            pair<int, int> coords = getTableIndex(state);
+            this->gameActions.push_back({
+                static_cast<unsigned char>(coords.first),
+                static_cast<unsigned char>(coords.second),
+                static_cast<unsigned char>(actionChosen)
+            });
+
+            return actionChosen;
+
+        }
+
         // add game data to training data
         void endGame(double reward) {
 
+            BJ_ALLOC_SCOPE(ALLOC_AGENT);
+
             // make sure there are game actions
             if (this->gameActions.size() == 0) {
                 return;
             }
 
-            // game value
-            pair<vector<Action>, double> gameValue = pair<vector<Action>, double>(this->gameActions, reward);
+            // add game to training examples
+            this->trainingSteps.insert(this->trainingSteps.end(), this->gameActions.begin(), this->gameActions.end());
+            this->trainingGames.push_back(pair<int, double>(this->gameActions.size(), reward));
 
-            // add all examples to training eg
-            this->trainingExamples.push_back(gameValue);
+            // empties game action list, keeping its memory
+            this->gameActions.clear();
 
-            // empties game action vector
-            vector<Action>().swap(this->gameActions);
+        }
+
+        // drops the split histories of the last game, call when a new game is dealt
+        void clearSplitHistory() {
+
+            this->splitHistory.clear();
 
         }
 
-        // train on training examples accumulated
-        void train() {
+        // saves the current game's actions for a split branch
+        // gives back where they were saved
+        void saveSplitHistory(int& historyStart, int& historyLength) {
+
+            BJ_ALLOC_SCOPE(ALLOC_AGENT);
+
+            historyStart = this->splitHistory.size();
+            historyLength = this->gameActions.size();
+            this->splitHistory.insert(this->splitHistory.end(), this->gameActions.begin(), this->gameActions.end());
+
+        }
+
+        // picks a saved history back up to play a split branch
+        void restoreSplitHistory(int historyStart, int historyLength) {
 
-            // list of game actions
-            vector<Action> gameActions;
+            BJ_ALLOC_SCOPE(ALLOC_AGENT);
 
-            // game reward 
-            double gameReward;
+            this->gameActions.assign(this->splitHistory.begin() + historyStart, this->splitHistory.begin() + historyStart + historyLength);
+
+        }
+
+        // drops the current game's actions without training on them
+        void clearGameActions() {
+
+            this->gameActions.clear();
+
+        }
+
+        // keeps room for a number of games between training batches
+        void reserveTraining(int gameCount) {
+
+            this->trainingGames.reserve(gameCount);
+            this->trainingSteps.reserve(gameCount * RESERVED_STEPS_PER_GAME);
+
+        }
+
+        // apply the update target to one episode, last action first
+        // fresh episodes also count as training examples and return samples
+        // returns the largest update error in the episode
+        double updateEpisode(const EpisodeStep* steps, int length, double gameReward, bool fresh) {
 
             // set highest q value for next state
-            double nextHighestQ;
+            double nextHighestQ = 0;
 
             // current iteration in actions
-            Action action;
+            EpisodeStep step;
 
-            // state coordinates
-            pair<int, int> stateIndices;
-            
             // highest q value befor they were updated
             double preUpdateHighestQ;
 
             // current q value for iterating
             double currentQValue;
 
-            // whether this is the last example with no future reward
-            bool lastExample;
+            // discounted game reward seen from the current action
+            double actionReturn = gameReward;
+
+            // lambda used for the target, 0 is one step q and 1 is monte carlo
+            double targetLambda = (this->updateTarget == MONTE_CARLO) ? 1 : (this->updateTarget == TD_LAMBDA) ? this->lambda : 0;
+
+            // update target for the current action and the one after it
+            double target;
+            double nextTarget = 0;
+
+            // largest update error
+            double largestError = 0;
+
+            // iterate through game actions backward
+            for (int t = length - 1; t >= 0; t --) {
+
+                // get current action
+                step = steps[t];
+
+                // get highest q value before update
+                preUpdateHighestQ = *max_element(this->qTable[step.row][step.col], this->qTable[step.row][step.col] + ACTION_TYPE_COUNT);
+
+                // as long as this isn't the last one
+                if (t != length - 1) {
+
+                    // target = currentReward + G((1 - lambda)(nextReward) + lambda(nextTarget))
+                    target = 0 + this->G * ((1 - targetLambda) * nextHighestQ + targetLambda * nextTarget);
+
+                }
+                // if it's the last one
+                else {
+
+                    // target = gameReward
+                    target = gameReward;
+
+                }
+
+                // get current q value
+                currentQValue = this->qTable[step.row][step.col][step.action];
+                largestError = max(largestError, fabs(target - currentQValue));
+
+                // update
+                // Q = Q + A(target - Q)
+                this->qTable[step.row][step.col][step.action] = currentQValue + this->stepSize(step.row, step.col, step.action) * (target - currentQValue);
+                nextTarget = target;
+
+                // fresh examples count toward training
+                if (fresh) {
+
+                    // update q values update
+                    this->trainingCounts[step.row][step.col][step.action] ++;
+                    this->trainingCountTotal ++;
+
+                    // update return statistics
+                    this->addReturn(step.row, step.col, step.action, actionReturn);
+                    actionReturn *= this->G;
+
+                }
+
+                // set next highest q value
+                nextHighestQ = preUpdateHighestQ;
+
+            }
+
+            return largestError;
+
+        }
+
+        // train on training examples accumulated
+        void train() {
+
+            BJ_TRACE_ZONE("train");
+
+            BJ_ALLOC_SCOPE(ALLOC_TRAIN);
+
+            // episode for replay
+            CompactEpisode episode;
+
+            // largest update error of an episode
+            double error;
+
+            // where the current game's steps start
+            int firstStep = 0;
 
             // iterate through games
-            // cout << "Opening examples" << endl;
-            for (unsigned int i = 0; i < this->trainingExamples.size(); i ++) {
+            for (unsigned int i = 0; i < this->trainingGames.size(); i ++) {
 
-                // get list of game actions
-                gameActions = this->trainingExamples.at(i).first;
+                // game steps are already in table coordinates
+                const EpisodeStep* gameSteps = this->trainingSteps.data() + firstStep;
+                int gameLength = this->trainingGames.at(i).first;
+                double reward = this->trainingGames.at(i).second;
+                firstStep += gameLength;
 
-                // get game reward 
-                gameReward = this->trainingExamples.at(i).second;
+                // train once on the new game
+                error = this->updateEpisode(gameSteps, gameLength, reward, true);
 
-                // iterate through game actions backward
-                lastExample = true;
-                while (gameActions.size() > 0) {
-                    
-                    // get current action
-                    action = gameActions.back();
+                // keep short games for replay
+                if (this->replay != nullptr && gameLength <= MAX_REPLAY_STEPS) {
 
-                    // get move coordinates
-                    stateIndices = getTableIndex(action.state);
+                    episode.reward = reward;
+                    episode.length = gameLength;
+                    for (int t = 0; t < gameLength; t ++) {
+                        episode.steps[t] = gameSteps[t];
+                    }
+                    this->replay->add(episode, error);
 
-                    // get highest q value before update
-                    preUpdateHighestQ = *max_element(this->qTable[stateIndices.first][stateIndices.second], this->qTable[stateIndices.first][stateIndices.second] + ACTION_TYPE_COUNT);
+                }
 
-                    // as long as this isn't the last one
-                    if (!lastExample) {
+            }
 
-                        // get current q value
-                        currentQValue = this->qTable[stateIndices.first][stateIndices.second][action.type];
+            // replay stored games in minibatches
+            if (this->replay != nullptr && this->replay->size() > 0) {
 
-                        // update
-                        // Q = Q + A(currentReward + G(nextReward) - Q)
-                        this->qTable[stateIndices.first][stateIndices.second][action.type] = currentQValue + this->A * (0 + this->G * nextHighestQ - currentQValue);
+                // replays owed for this batch, fractions carry to the next one
+                this->replayDebt += this->replayRatio * this->trainingGames.size();
+                while (this->replayDebt >= this->replayBatchSize) {
 
+                    // draw a minibatch
+                    for (int b = 0; b < this->replayBatchSize; b ++) {
+                        this->replayBatch.at(b) = this->replay->sample();
                     }
-                    // if it's the last one
-                    else {
 
-                        // get current q value
-                        currentQValue = this->qTable[stateIndices.first][stateIndices.second][action.type];
+                    // train on it and refresh priorities
+                    for (int b = 0; b < this->replayBatchSize; b ++) {
 
-                        // update
-                        // Q = Q + A(gameReward - Q)
-                        this->qTable[stateIndices.first][stateIndices.second][action.type] = currentQValue + this->A * (gameReward  - currentQValue);
+                        const CompactEpisode& stored = this->replay->getEpisode(this->replayBatch.at(b));
+                        error = this->updateEpisode(stored.steps, stored.length, stored.reward, false);
+                        this->replay->setPriority(this->replayBatch.at(b), error);
 
                     }
 
-                    // update q values update
-                    this->trainingCounts[stateIndices.first][stateIndices.second][action.type] ++;
-                    this->trainingCountTotal ++;
+                    this->replayDebt -= this->replayBatchSize;
+
+                }
+
+            }
+
+            // empty training examples, keeping their memory for the next batch
+            this->trainingSteps.clear();
+            this->trainingGames.clear();
+
+        }
 
-                    // set next highest q value
-                    nextHighestQ = preUpdateHighestQ;
+        // turn on replay
+        // buffer size is in games, ratio is replayed games per new game, priority exponent 0 is uniform
+        // batch size has to be at least 1 and the ratio not negative
+        void setReplay(int bufferSize, double replayRatio, int batchSize, double priorityExponent) {
 
-                    // pop the last training example
-                    gameActions.pop_back();
-                    lastExample = false;
+            // train pays replay debt off a batch at a time, a batch of nothing never pays it
+            assert(batchSize > 0 && replayRatio >= 0);
+
+            delete this->replay;
+            this->replay = new ReplayBuffer(bufferSize, priorityExponent, rand());
+            this->replayRatio = replayRatio;
+            this->replayBatchSize = batchSize;
+            this->replayBatch = vector<int>(batchSize);
+            this->replayDebt = 0;
+
+        }
+
+        // set the step size schedule
+        void setAlphaSchedule(AlphaSchedule schedule, double power) {
+
+            this->alphaSchedule = schedule;
+            this->alphaPower = power;
+
+        }
+
+        // set the update target
+        void setUpdateTarget(UpdateTarget updateTarget, double lambda) {
+
+            this->updateTarget = updateTarget;
+            this->lambda = lambda;
+
+        }
+
+        // step size for the next update of a q value
+        double stepSize(int row, int col, int actionType) const {
+
+            // updates including this one
+            double n = this->trainingCounts[row][col][actionType] + 1;
+
+            switch (this->alphaSchedule) {
+
+                case SAMPLE_AVERAGE_ALPHA:
+                    return 1 / n;
+
+                case POLYNOMIAL_ALPHA:
+                    return 1 / pow(n, this->alphaPower);
+
+                case CLAMPED_ALPHA:
+                    return max(this->A, 1 / n);
+
+                default:
+                    return this->A;
+
+            }
+
+        }
+
+        // add a return to the running statistics of a q value
+        void addReturn(int row, int col, int actionType, double value) {
+
+            // welford update
+            this->returnCounts[row][col][actionType] ++;
+            double delta = value - this->returnMeans[row][col][actionType];
+            this->returnMeans[row][col][actionType] += delta / this->returnCounts[row][col][actionType];
+            this->returnM2[row][col][actionType] += delta * (value - this->returnMeans[row][col][actionType]);
+
+        }
+
+        // sample variance of the returns for a q value
+        double getReturnVariance(int row, int col, int actionType) const {
+
+            // not enough returns for a variance
+            if (this->returnCounts[row][col][actionType] < 2) {
+                return numeric_limits<double>::infinity();
+            }
+
+            return this->returnM2[row][col][actionType] / (this->returnCounts[row][col][actionType] - 1);
+
+        }
+
+        // gap in mean return between the best and second best action of a cell
+        // half width is for the confidence interval on the gap, infinite if undecided by lack of data
+        // returns false if the cell has no returns for two actions yet
+        bool getActionGap(int row, int col, double& gap, double& halfWidth) const {
+
+            // split only counts on pair rows
+            int actionCount = handIdxCanSplit(row) ? ACTION_TYPE_COUNT : SPLIT;
+
+            // find best and second best actions by mean return
+            int best = -1;
+            int second = -1;
+            for (int k = 0; k < actionCount; k ++) {
+
+                // skip actions with no returns
+                if (this->returnCounts[row][col][k] == 0) {
+                    continue;
+                }
+
+                if (best == -1 || this->returnMeans[row][col][k] > this->returnMeans[row][col][best]) {
+
+                    second = best;
+                    best = k;
 
                 }
+                else if (second == -1 || this->returnMeans[row][col][k] > this->returnMeans[row][col][second]) {
+
+                    second = k;
+
+                }
+
+            }
+
+            // need two actions to compare
+            if (second == -1) {
+
+                gap = 0;
+                halfWidth = numeric_limits<double>::infinity();
+                return false;
 
             }
 
-            // empty training examples
-            vector<pair<vector<Action>, double>>().swap(this->trainingExamples);
+            // standard error of the difference of two independent means
+            gap = this->returnMeans[row][col][best] - this->returnMeans[row][col][second];
+            double bestSe = this->getReturnVariance(row, col, best) / this->returnCounts[row][col][best];
+            double secondSe = this->getReturnVariance(row, col, second) / this->returnCounts[row][col][second];
+            halfWidth = CI_Z * sqrt(bestSe + secondSe);
+
+            return true;
 
         }
 
-        // set game action history for splits
-        void setGameActions(vector<Action> actions) {
-            this->gameActions = actions;
+        // sampling weight for each cell by how undecided its best action is
+        // weight is the normal tail chance that the best action is really behind the second
+        void getUndecidedWeights(double weights[][DEALER_HAND_COUNT]) const {
+
+            double gap;
+            double halfWidth;
+
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+                    // cells without data are as undecided as they get
+                    if (!this->getActionGap(i, j, gap, halfWidth) || halfWidth == numeric_limits<double>::infinity()) {
+
+                        weights[i][j] = 0.5;
+                        continue;
+
+                    }
+
+                    // chance of a gap this size or more if the actions were equal
+                    // P(Z > gap / se) = erfc(gap / (se * sqrt(2))) / 2
+                    double se = halfWidth / CI_Z;
+                    weights[i][j] = (se > 0) ? 0.5 * erfc(gap / (se * sqrt(2.0))) : 0;
+                    weights[i][j] = max(weights[i][j], SETTLED_CELL_WEIGHT);
+
+                }
+            }
+
         }
 
-        // get all actions of the game so far
-        vector<Action> getGameActions() const {
-            return this->gameActions;
+        // number of decisions trained on so far
+        int getTrainingCountTotal() const {
+            return this->trainingCountTotal;
         }
 
         // get table
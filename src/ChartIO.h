@@ -0,0 +1,395 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: writes the chart file set for a q table
+*/
+
+// file guards
+#ifndef CHART_IO_H
+#define CHART_IO_H
+
+// imports
+#include <string>
+#include <fstream>
+#include <limits>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <filesystem>
+#include "BlackJackAgent.h"
+#include "Trace.h"
+#include "AllocTracker.h"
+
+// namespace
+using std::string;
+using std::ofstream, std::ifstream;
+using std::getline, std::stoi;
+using std::numeric_limits;
+using std::setw, std::fixed;
+using std::max_element, std::sort;
+using std::vector;
+namespace fs = std::filesystem;
+
+// builds the readable chart values for a q table without changing it
+// same choices as the readable csv, split only counts on pair rows
+void buildChart(const double (*qTable)[DEALER_HAND_COUNT][ACTION_TYPE_COUNT], int chart[][DEALER_HAND_COUNT]) {
+
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            // get highest q value index
+            int actionCount = handIdxCanSplit(i) ? ACTION_TYPE_COUNT : SPLIT;
+            int maxQ = max_element(qTable[i][j], qTable[i][j] + actionCount) - qTable[i][j];
+
+            // double falls back to whichever of stand and hit is better
+            if (maxQ == DOUBLE) {
+
+                chart[i][j] = (qTable[i][j][STAND] > qTable[i][j][HIT]) ? DOUBLE_STAND : DOUBLE_HIT;
+
+            }
+            else {
+
+                chart[i][j] = maxQ;
+
+            }
+
+        }
+    }
+
+}
+
+// path of a chart's readable csv from src
+string readableChartPath(const string& chartId) {
+
+    return "../charts/Chart" + chartId + "/Chart" + chartId + "_readable.csv";
+
+}
+
+// ids of every chart folder in a charts folder that has a readable csv
+// numbered ids come first in number order, then the rest by name
+vector<string> findChartIds(const string& chartsDir) {
+
+    vector<string> chartIds;
+    for (const fs::directory_entry& entry : fs::directory_iterator(chartsDir)) {
+
+        string name = entry.path().filename().string();
+        if (!entry.is_directory() || name.compare(0, 5, "Chart") != 0) {
+            continue;
+        }
+
+        string chartId = name.substr(5);
+        if (fs::exists(entry.path() / ("Chart" + chartId + "_readable.csv"))) {
+            chartIds.push_back(chartId);
+        }
+
+    }
+
+    // sort ids
+    sort(chartIds.begin(), chartIds.end(), [](const string& a, const string& b) -> bool {
+
+        bool aNumber = !a.empty() && a.find_first_not_of("0123456789") == string::npos;
+        bool bNumber = !b.empty() && b.find_first_not_of("0123456789") == string::npos;
+        if (aNumber && bNumber) {
+            return stoi(a) < stoi(b);
+        }
+        if (aNumber != bNumber) {
+            return aNumber;
+        }
+        return a < b;
+
+    });
+
+    return chartIds;
+
+}
+
+// reads a readable chart csv into chart values
+// returns false if the file can't be opened
+bool loadChart(const string& path, int chart[][DEALER_HAND_COUNT]) {
+
+    BJ_TRACE_ZONE("read chart csv");
+    BJ_ALLOC_SCOPE(ALLOC_CHART_IO);
+
+    // open file stream to populate chart
+    ifstream infile(path);
+    string readIn;
+    if (!infile) {
+        return false;
+    }
+
+    // read in header
+    getline(infile, readIn);
+
+    // iterate through player hands
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+        // read in row label
+        getline(infile, readIn, ',');
+
+        // read in all dealer hands except last
+        for (int j = 0; j < DEALER_HAND_COUNT - 1; j ++) {
+
+            // put action in chart
+            getline(infile, readIn, ',');
+            chart[i][j] = stoi(readIn);
+
+        }
+
+        // read in last \n delimited item
+        getline(infile, readIn);
+        chart[i][DEALER_HAND_COUNT - 1] = stoi(readIn);
+
+    }
+
+    return true;
+
+}
+
+// number of cells two charts disagree on
+int chartDifference(const int chart1[][DEALER_HAND_COUNT], const int chart2[][DEALER_HAND_COUNT]) {
+
+    int differences = 0;
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            differences += (chart1[i][j] != chart2[i][j]) ? 1 : 0;
+
+        }
+    }
+
+    return differences;
+
+}
+
+// writes the chart, readable chart, backing, q and whole backing csvs for a chart id
+// split values of rows that can't split are left out, the q table isn't changed
+void writeChartFiles(const string& CHART_ID, const double (*qTable)[DEALER_HAND_COUNT][ACTION_TYPE_COUNT], int (*counts)[DEALER_HAND_COUNT][ACTION_TYPE_COUNT]) {
+
+    BJ_TRACE_ZONE("write chart files");
+    BJ_ALLOC_SCOPE(ALLOC_CHART_IO);
+
+    // chart names
+    const string CHART_NAME = "Chart" + CHART_ID + ".csv";
+
+    // chart that can be used by computer
+    const string USABLE_CHART_NAME = "Chart" + CHART_ID + "_readable.csv";
+
+    // chart saying training examples for each max q action
+    const string MAX_TRAINING_CHART_NAME = "Chart" + CHART_ID + "_backing.csv";
+
+    // chart saying all q values
+    const string Q_CHART_NAME = "Chart" + CHART_ID + "_Q.csv";
+
+    // chart saying all training examples
+    const string TRAINING_CHART_NAME = "Chart" + CHART_ID + "_wholeBacking.csv";
+
+    // chart choices, split only counts on pair rows
+    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+    buildChart(qTable, chart);
+
+    // open chart
+    ofstream outfile(CHART_NAME);
+
+    // write top left corner
+    outfile << ",";
+
+    // write header
+    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
+
+        outfile << DEALER_HANDS[i] << ",";
+
+    }
+    outfile << endl;
+
+    // iterate through possible hand combos
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+        // print player hand
+        outfile << PLAYER_HANDS[i] << ",";
+
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            // print action
+            outfile << ACTION_NAMES[chart[i][j]] << ",";
+
+        }
+
+        outfile << endl;
+    }
+    outfile.close();
+
+
+    // open chart that is usable
+    outfile.open(USABLE_CHART_NAME);
+
+    // write top left corner
+    outfile << ",";
+
+    // write header
+    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
+
+        outfile << DEALER_HANDS[i] << ",";
+
+    }
+    outfile << endl;
+
+    // iterate through possible hand combos
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+        // print player hand
+        outfile << PLAYER_HANDS[i] << ",";
+
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            // print action
+            outfile << chart[i][j] << ",";
+
+        }
+
+        outfile << endl;
+    }
+    outfile.close();
+
+
+    // print training counts
+    outfile.open(MAX_TRAINING_CHART_NAME);
+
+    // write top left corner
+    outfile << ",";
+
+    // write header
+    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
+
+        outfile << DEALER_HANDS[i] << ",";
+
+    }
+    outfile << endl;
+
+    // iterate through possible hand combos
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+        // print player hand
+        outfile << PLAYER_HANDS[i] << ",";
+
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            // action the chart takes, doubles with either fallback were trained as a double
+            int action = (chart[i][j] == DOUBLE_STAND || chart[i][j] == DOUBLE_HIT) ? DOUBLE : chart[i][j];
+
+            // print action
+            outfile << counts[i][j][action] << ",";
+
+        }
+
+        outfile << endl;
+    }
+    outfile.close();
+
+
+    // print q values
+    outfile.open(Q_CHART_NAME);
+
+    // write top left corner
+    outfile << ",";
+
+    // write header
+    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
+
+        outfile << DEALER_HANDS[i] << ",";
+
+    }
+    outfile << endl;
+
+    // iterate through possible hand combos
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+        // print player hand
+        outfile << PLAYER_HANDS[i] << ",";
+
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            // print q values
+            outfile << "[" << setw(4) << fixed;
+
+            for (int k = 0; k < ACTION_TYPE_COUNT - 1; k ++) {
+
+                // print action if not numerical min
+                if (qTable[i][j][k] == numeric_limits<int>::min()) {
+
+                    outfile << " _  ";
+
+                }
+                else {
+
+                    outfile << qTable[i][j][k] << " ";
+
+                }
+
+            }
+
+            // print split if not numerical min and the row can split
+            if (qTable[i][j][ACTION_TYPE_COUNT - 1] == numeric_limits<int>::min() || !handIdxCanSplit(i)) {
+
+                outfile << " _ ";
+
+            }
+            else {
+
+                outfile << qTable[i][j][ACTION_TYPE_COUNT - 1];
+
+            }
+
+            outfile << "],";
+
+        }
+
+        outfile << endl;
+    }
+    outfile.close();
+
+
+    // print all training counts
+    outfile.open(TRAINING_CHART_NAME);
+
+    // write top left corner
+    outfile << ",";
+
+    // write header
+    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
+
+        outfile << DEALER_HANDS[i] << ",";
+
+    }
+    outfile << endl;
+
+    // iterate through possible hand combos
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+        // print player hand
+        outfile << PLAYER_HANDS[i] << ",";
+
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            // print q values
+            outfile << "[";
+
+            for (int k = 0; k < ACTION_TYPE_COUNT - 1; k ++) {
+
+                // print action
+                outfile << counts[i][j][k] << " ";
+
+            }
+
+            outfile << counts[i][j][ACTION_TYPE_COUNT - 1];
+
+            outfile << "],";
+
+        }
+
+        outfile << endl;
+    }
+    outfile.close();
+
+}
+
+#endif
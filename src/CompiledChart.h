@@ -0,0 +1,237 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: packed chart with double fallbacks worked out ahead of time
+*/
+
+// file guards
+#ifndef COMPILED_CHART_H
+#define COMPILED_CHART_H
+
+// imports
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "ChartIO.h"
+#include "Trace.h"
+#include "AllocTracker.h"
+
+// namespace
+using std::string;
+using std::ifstream, std::ofstream;
+using std::ios;
+using std::invalid_argument, std::out_of_range;
+
+// one byte per chart cell, rows then columns
+const int COMPILED_CHART_SIZE = PLAYER_HAND_COUNT * DEALER_HAND_COUNT;
+
+// each byte holds the action for a 2 card hand in the low 4 bits
+// and the action once the hand has more cards in the high 4 bits
+const int LATER_ACTION_SHIFT = 4;
+const unsigned char ACTION_MASK = 0xF;
+
+// number of values a readable chart cell can have
+const int CHART_VALUE_COUNT = 6;
+
+// row of hard 21, always stood on
+const int HARD_21_ROW = 16;
+
+// packed chart
+struct CompiledChart {
+
+    unsigned char cells[COMPILED_CHART_SIZE];
+
+};
+
+// checks readable chart values
+// returns false with the reason if a cell can't be played
+bool validateChart(const int chart[][DEALER_HAND_COUNT], string& error) {
+
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+            // cell label for errors
+            string cell = PLAYER_HANDS[i] + " vs " + DEALER_HANDS[j];
+
+            // known action
+            if (chart[i][j] < 0 || chart[i][j] >= CHART_VALUE_COUNT) {
+
+                error = cell + ": unknown action " + std::to_string(chart[i][j]);
+                return false;
+
+            }
+
+            // split only on pairs
+            if (chart[i][j] == SPLIT && !handIdxCanSplit(i)) {
+
+                error = cell + ": SPLIT on a row that isn't a pair";
+                return false;
+
+            }
+
+        }
+    }
+
+    return true;
+
+}
+
+// packs one readable chart value for a row
+// doubles become DOUBLE for 2 card hands and their fallback for bigger hands,
+// the same way eval has always read them
+unsigned char compileCell(int row, int value) {
+
+    int first = value;
+    int later = value;
+
+    // double fallbacks
+    if (value == DOUBLE_HIT) {
+
+        first = DOUBLE;
+        later = HIT;
+
+    }
+    else if (value == DOUBLE_STAND) {
+
+        first = DOUBLE;
+        later = STAND;
+
+    }
+
+    // player has to stand on 21
+    if (row == HARD_21_ROW) {
+
+        first = STAND;
+        later = STAND;
+
+    }
+
+    return first | (later << LATER_ACTION_SHIFT);
+
+}
+
+// packs readable chart values, the chart should be validated first
+void compileChart(const int chart[][DEALER_HAND_COUNT], CompiledChart& compiled) {
+
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+            compiled.cells[i * DEALER_HAND_COUNT + j] = compileCell(i, chart[i][j]);
+        }
+    }
+
+}
+
+// cell of a packed chart a state reads
+int compiledCellIndex(const Hands& state) {
+
+    pair<int, int> stateCoords = getTableIndex(state);
+    return stateCoords.first * DEALER_HAND_COUNT + stateCoords.second;
+
+}
+
+// gets the action a packed chart says to take in a state
+// one table load, the card count only picks which half of the byte to use
+ActionType compiledMove(const unsigned char* cells, const Hands& state) {
+
+    int shift = (state.playerCards.size() != 2) * LATER_ACTION_SHIFT;
+
+    return static_cast<ActionType>((cells[compiledCellIndex(state)] >> shift) & ACTION_MASK);
+
+}
+ActionType compiledMove(const CompiledChart& compiled, const Hands& state) {
+
+    return compiledMove(compiled.cells, state);
+
+}
+
+// path of a chart's packed file from src
+string compiledChartPath(const string& chartId) {
+
+    return "../charts/Chart" + chartId + "/Chart" + chartId + ".bin";
+
+}
+
+// writes a packed chart file
+bool writeCompiledChart(const string& path, const CompiledChart& compiled) {
+
+    BJ_TRACE_ZONE("write packed chart");
+    BJ_ALLOC_SCOPE(ALLOC_CHART_IO);
+    ofstream outfile(path, ios::binary);
+    outfile.write(reinterpret_cast<const char*>(compiled.cells), COMPILED_CHART_SIZE);
+
+    return outfile.good();
+
+}
+
+// reads a packed chart file straight into the table
+// returns false if it can't be opened or is the wrong size
+bool loadCompiledChart(const string& path, CompiledChart& compiled) {
+
+    ifstream infile(path, ios::binary);
+    infile.read(reinterpret_cast<char*>(compiled.cells), COMPILED_CHART_SIZE);
+
+    return infile.gcount() == COMPILED_CHART_SIZE && infile.peek() == EOF;
+
+}
+
+// loads a chart by id from its packed file, or from its readable csv if there is no
+// packed file or the csv is newer
+// returns false with the reason if it can't be loaded
+bool loadChartById(const string& chartId, CompiledChart& compiled, string& error) {
+
+    BJ_TRACE_ZONE("load chart");
+    BJ_ALLOC_SCOPE(ALLOC_CHART_IO);
+    const string readablePath = readableChartPath(chartId);
+    const string compiledPath = compiledChartPath(chartId);
+
+    // packed file
+    bool packedCurrent = fs::exists(compiledPath) && (!fs::exists(readablePath) || fs::last_write_time(compiledPath) >= fs::last_write_time(readablePath));
+    if (packedCurrent) {
+
+        if (!loadCompiledChart(compiledPath, compiled)) {
+
+            error = "bad packed chart " + compiledPath;
+            return false;
+
+        }
+        return true;
+
+    }
+
+    // readable csv
+    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+    try {
+
+        if (!loadChart(readablePath, chart)) {
+
+            error = "can't open chart " + readablePath;
+            return false;
+
+        }
+
+    }
+    catch (const invalid_argument&) {
+
+        error = "bad value in " + readablePath;
+        return false;
+
+    }
+    catch (const out_of_range&) {
+
+        error = "bad value in " + readablePath;
+        return false;
+
+    }
+    if (!validateChart(chart, error)) {
+        return false;
+    }
+    compileChart(chart, compiled);
+
+    return true;
+
+}
+
+#endif
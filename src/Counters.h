@@ -0,0 +1,217 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: per thread event counters for the game and agent, written out as json and prometheus text
+*/
+
+// file guards
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+// counters are on unless built with -DBJ_COUNTERS=0, which compiles every count away
+#ifndef BJ_COUNTERS
+#define BJ_COUNTERS 1
+#endif
+
+// imports
+#include <string>
+#include <fstream>
+#include <mutex>
+
+// namespace
+using std::string, std::to_string;
+using std::ofstream, std::endl;
+using std::mutex, std::lock_guard;
+
+// events counted
+enum CounterType {
+
+    RESHUFFLES,
+    CARDS_DEALT,
+    HANDS_DEALT,
+    PLAYER_NATURALS,
+    DEALER_NATURALS,
+    SPLITS,
+    SPLITS_AT_DEPTH_1,
+    SPLITS_AT_DEPTH_2,
+    SPLITS_AT_DEPTH_3,
+    SPLITS_AT_DEPTH_4_PLUS,
+    DOUBLES,
+    PLAYER_BUSTS,
+    DEALER_HANDS_PLAYED,
+    DEALER_DRAWS,
+    DEALER_BUSTS,
+    EXPLORE_DECISIONS,
+    EXPLOIT_DECISIONS
+
+};
+const int COUNTER_COUNT = 17;
+
+// split depth is how many splits a dealt hand has had, counting the one being made
+// the last bucket holds every deeper split
+const int SPLIT_DEPTH_BUCKETS = 4;
+
+// counter names, also the metric names
+const string COUNTER_NAMES[] = {
+    "reshuffles",
+    "cards_dealt",
+    "hands_dealt",
+    "player_naturals",
+    "dealer_naturals",
+    "splits",
+    "splits_at_depth_1",
+    "splits_at_depth_2",
+    "splits_at_depth_3",
+    "splits_at_depth_4_plus",
+    "doubles",
+    "player_busts",
+    "dealer_hands_played",
+    "dealer_draws",
+    "dealer_busts",
+    "explore_decisions",
+    "exploit_decisions"
+};
+
+// what each counter counts, for the prometheus help lines
+const string COUNTER_HELP[] = {
+    "Shoes shuffled",
+    "Cards dealt off the shoe",
+    "Starting hands dealt",
+    "Player two card 21s",
+    "Dealer two card 21s",
+    "Hands split",
+    "First splits of a dealt hand",
+    "Second splits of a dealt hand",
+    "Third splits of a dealt hand",
+    "Fourth or later splits of a dealt hand",
+    "Bets doubled",
+    "Player hands busted",
+    "Dealer turns played",
+    "Cards the dealer drew on their turn",
+    "Dealer hands busted",
+    "Agent moves picked at random",
+    "Agent moves picked by best q value"
+};
+
+// counts of finished threads, added to under a lock when a thread ends
+mutex counterLock;
+long long finishedCounters[COUNTER_COUNT] = {};
+
+// one thread's counts
+// adding is a plain increment, the block hands its counts over when its thread ends
+struct CounterBlock {
+
+    long long values[COUNTER_COUNT] = {};
+
+    ~CounterBlock() {
+
+        lock_guard<mutex> guard(counterLock);
+        for (int c = 0; c < COUNTER_COUNT; c ++) {
+            finishedCounters[c] += this->values[c];
+        }
+
+    }
+
+};
+thread_local CounterBlock threadCounters;
+
+// count an event on this thread
+#if BJ_COUNTERS
+#define BJ_COUNT(counter) (threadCounters.values[counter] ++)
+#define BJ_COUNT_SPLIT_DEPTH(depth) (threadCounters.values[SPLITS_AT_DEPTH_1 + (((depth) < SPLIT_DEPTH_BUCKETS) ? (depth) - 1 : SPLIT_DEPTH_BUCKETS - 1)] ++)
+#else
+#define BJ_COUNT(counter) ((void) 0)
+#define BJ_COUNT_SPLIT_DEPTH(depth) ((void) 0)
+#endif
+
+// totals of every finished thread and the calling one
+// worker threads have to be joined first for their counts to be in
+void collectCounters(long long totals[]) {
+
+    lock_guard<mutex> guard(counterLock);
+    for (int c = 0; c < COUNTER_COUNT; c ++) {
+        totals[c] = finishedCounters[c] + threadCounters.values[c];
+    }
+
+}
+
+// a count per another count, 0 if there is nothing to divide by
+double counterRatio(long long count, long long per) {
+
+    return (per > 0) ? static_cast<double>(count) / per : 0;
+
+}
+
+// writes totals as json with a few ratios that show how the games played out
+bool writeCountersJson(const string& path, const long long totals[]) {
+
+    ofstream outfile(path);
+    outfile << "{" << endl;
+    outfile << "  \"enabled\": " << (BJ_COUNTERS ? "true" : "false") << "," << endl;
+    outfile << "  \"counters\": {" << endl;
+    for (int c = 0; c < COUNTER_COUNT; c ++) {
+        outfile << "    \"" << COUNTER_NAMES[c] << "\": " << totals[c] << ((c + 1 < COUNTER_COUNT) ? "," : "") << endl;
+    }
+    outfile << "  }," << endl;
+    outfile << "  \"ratios\": {" << endl;
+    outfile << "    \"cards_per_hand\": " << counterRatio(totals[CARDS_DEALT], totals[HANDS_DEALT]) << "," << endl;
+    outfile << "    \"splits_per_hand\": " << counterRatio(totals[SPLITS], totals[HANDS_DEALT]) << "," << endl;
+    outfile << "    \"doubles_per_hand\": " << counterRatio(totals[DOUBLES], totals[HANDS_DEALT]) << "," << endl;
+    outfile << "    \"player_naturals_per_hand\": " << counterRatio(totals[PLAYER_NATURALS], totals[HANDS_DEALT]) << "," << endl;
+    outfile << "    \"dealer_draws_per_dealer_hand\": " << counterRatio(totals[DEALER_DRAWS], totals[DEALER_HANDS_PLAYED]) << "," << endl;
+    outfile << "    \"dealer_bust_rate\": " << counterRatio(totals[DEALER_BUSTS], totals[DEALER_HANDS_PLAYED]) << "," << endl;
+    outfile << "    \"explore_rate\": " << counterRatio(totals[EXPLORE_DECISIONS], totals[EXPLORE_DECISIONS] + totals[EXPLOIT_DECISIONS]) << endl;
+    outfile << "  }" << endl;
+    outfile << "}" << endl;
+
+    return outfile.good();
+
+}
+
+// writes totals in the prometheus text exposition format
+// split depths are one metric with a depth label
+bool writeCountersPrometheus(const string& path, const long long totals[]) {
+
+    ofstream outfile(path);
+    for (int c = 0; c < COUNTER_COUNT; c ++) {
+
+        // split depth buckets go under one metric
+        if (c >= SPLITS_AT_DEPTH_1 && c <= SPLITS_AT_DEPTH_4_PLUS) {
+
+            if (c == SPLITS_AT_DEPTH_1) {
+
+                outfile << "# HELP blackjack_splits_by_depth_total Splits by how many splits their dealt hand had so far, this one included" << endl;
+                outfile << "# TYPE blackjack_splits_by_depth_total counter" << endl;
+
+            }
+            int depth = c - SPLITS_AT_DEPTH_1 + 1;
+            string label = (depth == SPLIT_DEPTH_BUCKETS) ? to_string(depth) + "+" : to_string(depth);
+            outfile << "blackjack_splits_by_depth_total{depth=\"" << label << "\"} " << totals[c] << endl;
+            continue;
+
+        }
+
+        outfile << "# HELP blackjack_" << COUNTER_NAMES[c] << "_total " << COUNTER_HELP[c] << endl;
+        outfile << "# TYPE blackjack_" << COUNTER_NAMES[c] << "_total counter" << endl;
+        outfile << "blackjack_" << COUNTER_NAMES[c] << "_total " << totals[c] << endl;
+
+    }
+
+    return outfile.good();
+
+}
+
+// collects every thread's counts and writes <base>_counters.json and <base>_counters.prom
+bool writeCounterFiles(const string& basePath) {
+
+    long long totals[COUNTER_COUNT];
+    collectCounters(totals);
+
+    bool jsonWritten = writeCountersJson(basePath + "_counters.json", totals);
+    bool promWritten = writeCountersPrometheus(basePath + "_counters.prom", totals);
+
+    return jsonWritten && promWritten;
+
+}
+
+#endif
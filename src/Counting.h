@@ -0,0 +1,225 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: true count buckets with a chart and bet size for each
+*/
+
+// file guards
+#ifndef COUNTING_H
+#define COUNTING_H
+
+// imports
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "CompiledChart.h"
+#include "Options.h"
+
+// namespace
+using std::string, std::to_string;
+using std::vector;
+using std::ifstream;
+using std::stringstream;
+using std::getline;
+using std::floor;
+using std::atof, std::atoi;
+
+// true count buckets are floored true counts, with everything at or past
+// the ends put in the end buckets
+const int COUNT_BUCKET_MIN = -3;
+const int COUNT_BUCKET_MAX = 6;
+const int COUNT_BUCKET_COUNT = COUNT_BUCKET_MAX - COUNT_BUCKET_MIN + 1;
+
+// bucket of a true count
+int countBucket(double trueCount) {
+
+    int count = floor(trueCount);
+    if (count < COUNT_BUCKET_MIN) {
+        count = COUNT_BUCKET_MIN;
+    }
+    else if (count > COUNT_BUCKET_MAX) {
+        count = COUNT_BUCKET_MAX;
+    }
+
+    return count - COUNT_BUCKET_MIN;
+
+}
+
+// floored true count a bucket stands for
+int bucketCount(int bucket) {
+
+    return bucket + COUNT_BUCKET_MIN;
+
+}
+
+// name of a bucket for results
+string bucketLabel(int bucket) {
+
+    int count = bucketCount(bucket);
+    string label = (count > 0) ? "+" + to_string(count) : to_string(count);
+    if (count == COUNT_BUCKET_MIN) {
+        return "<=" + label;
+    }
+    if (count == COUNT_BUCKET_MAX) {
+        return ">=" + label;
+    }
+
+    return label;
+
+}
+
+// chart and bet size for each true count bucket
+// buckets start with the base chart and a bet of 1 unit
+class CountStrategy {
+
+    private:
+
+        // chart played in each bucket
+        vector<CompiledChart> bucketCharts;
+
+        // bet units in each bucket
+        double bucketUnits[COUNT_BUCKET_COUNT];
+
+    public:
+
+        // constructor
+        CountStrategy(const CompiledChart& baseChart) {
+
+            this->bucketCharts = vector<CompiledChart>(COUNT_BUCKET_COUNT, baseChart);
+            for (int b = 0; b < COUNT_BUCKET_COUNT; b ++) {
+                this->bucketUnits[b] = 1;
+            }
+
+        }
+
+        // play a chart in every bucket at or above a true count
+        void setChartFrom(int minCount, const CompiledChart& chart) {
+
+            for (int b = countBucket(minCount); b < COUNT_BUCKET_COUNT; b ++) {
+                this->bucketCharts.at(b) = chart;
+            }
+
+        }
+
+        // reads a bet ramp of true count:units pairs, e.g. 1:2,2:4,3:8
+        // each pair sets the bet in every bucket at or above its true count
+        // returns false if it can't be read
+        bool setBetRamp(const string& ramp) {
+
+            stringstream rampStream(ramp);
+            string step;
+            while (getline(rampStream, step, ',')) {
+
+                size_t colon = step.find(':');
+                if (colon == string::npos) {
+                    return false;
+                }
+                int minCount = atoi(step.substr(0, colon).c_str());
+                double units = atof(step.substr(colon + 1).c_str());
+                if (units <= 0) {
+                    return false;
+                }
+
+                for (int b = countBucket(minCount); b < COUNT_BUCKET_COUNT; b ++) {
+                    this->bucketUnits[b] = units;
+                }
+
+            }
+
+            return true;
+
+        }
+
+        // reads index plays from a csv of hand,dealer,direction,index,action lines
+        // e.g. 16,10,>=,0,STAND plays STAND on 16 vs 10 in buckets with true count 0 or more
+        // and 13,2,<=,-1,HIT plays HIT on 13 vs 2 in buckets with true count -1 or less
+        // later lines win over earlier ones, returns false with the reason if a line is bad
+        bool addDeviations(const string& path, string& error) {
+
+            ifstream infile(path);
+            if (!infile) {
+
+                error = "can't open " + path;
+                return false;
+
+            }
+
+            string line;
+            int lineNum = 0;
+            while (getline(infile, line)) {
+
+                lineNum ++;
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (line.empty() || line.at(0) == '#') {
+                    continue;
+                }
+
+                // split fields
+                vector<string> fields;
+                stringstream lineStream(line);
+                string field;
+                while (getline(lineStream, field, ',')) {
+                    fields.push_back(field);
+                }
+                if (fields.size() != 5) {
+
+                    error = path + " line " + to_string(lineNum) + ": expected hand,dealer,direction,index,action";
+                    return false;
+
+                }
+
+                // cell, direction and action
+                int row = findName(PLAYER_HANDS, PLAYER_HAND_COUNT, fields.at(0));
+                int col = findName(DEALER_HANDS, DEALER_HAND_COUNT, fields.at(1));
+                bool atOrAbove = fields.at(2) == ">=";
+                int index = atoi(fields.at(3).c_str());
+                int action = findName(ACTION_NAMES, CHART_VALUE_COUNT, fields.at(4));
+                if (row == -1 || col == -1 || (!atOrAbove && fields.at(2) != "<=") || action == -1) {
+
+                    error = path + " line " + to_string(lineNum) + ": unknown hand, dealer card, direction or action";
+                    return false;
+
+                }
+                if (action == SPLIT && !handIdxCanSplit(row)) {
+
+                    error = path + " line " + to_string(lineNum) + ": SPLIT on a row that isn't a pair";
+                    return false;
+
+                }
+
+                // set cell in the buckets past the index
+                for (int b = 0; b < COUNT_BUCKET_COUNT; b ++) {
+
+                    int count = bucketCount(b);
+                    if ((atOrAbove && count >= index) || (!atOrAbove && count <= index)) {
+                        this->bucketCharts.at(b).cells[row * DEALER_HAND_COUNT + col] = compileCell(row, action);
+                    }
+
+                }
+
+            }
+
+            return true;
+
+        }
+
+        // chart for a bucket
+        const CompiledChart& getChart(int bucket) const {
+            return this->bucketCharts[bucket];
+        }
+
+        // bet units for a bucket
+        double getUnits(int bucket) const {
+            return this->bucketUnits[bucket];
+        }
+
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: plays hands by a chart for evaluation
+*/
+
+// file guards
+#ifndef EVAL_H
+#define EVAL_H
+
+// imports
+#include <vector>
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "CompiledChart.h"
+
+// namespace
+using std::vector;
+
+// plays the player's moves by chart until they stand, double or the game ends
+// the chart cell of every decision is added to visited when it's set
+// returns game over flag
+bool playChartMoves(Game* game, const CompiledChart& chart, vector<SplitInfo>& splits, bool gameOver, bool& doubled, vector<unsigned short>* visited) {
+
+    // split branch being set up
+    SplitInfo split;
+
+    // set default agent move for iteration
+    ActionType agentMove = HIT;
+    doubled = false;
+
+    // while the game isn't over and player isn't done making moves
+    while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
+
+        // get player move
+        agentMove = compiledMove(chart, game->getState());
+        if (visited) {
+            visited->push_back(compiledCellIndex(game->getState()));
+        }
+
+        // carry out agent move
+        switch (agentMove) {
+
+            // agent hit
+            case HIT:
+
+                // hit in game
+                gameOver = game->hit();
+                break;
+
+            case SPLIT:
+
+                // add split info to split list to play other side of game
+                split = {
+                    game->getState().playerCards.at(0),
+                    game->getState().dealerShowing,
+                    game->getDealerSecondCard()
+                };
+                splits.push_back(split);
+
+                // setup this half of the game
+                game->runSplit();
+
+                break;
+
+            // agent double
+            case DOUBLE:
+
+                // double bet in game
+                game->doubleBet();
+                doubled = true;
+
+                // take hit
+                gameOver = game->hit();
+                break;
+
+            // agent stand
+            default:
+
+                break;
+
+        }
+
+    }
+
+    return gameOver;
+
+}
+
+// plays a dealt hand and every split branch by chart
+// returns the balance change in bets the way eval has always counted it:
+// each hand pays its bet (twice if doubled) and gets back the bet plus score times bet
+// with visited set, the chart cells the hand's decisions read are added to it
+double playChartHand(Game* game, const CompiledChart& chart, vector<SplitInfo>& splits, vector<unsigned short>* visited = nullptr) {
+
+    BJ_ALLOC_SCOPE(ALLOC_HAND_LOOP);
+
+    // balance change in bets
+    double change = 0;
+
+    // player doubled the current hand
+    bool doubled;
+
+    // split branch being played
+    SplitInfo split;
+
+    // deal game and play player moves
+    bool gameOver = playChartMoves(game, chart, splits, game->dealHands(), doubled, visited);
+
+    // player dealer turn if game isn't over
+    if (!gameOver) {
+
+        game->playDealer();
+
+    }
+
+    // update balance
+    change += game->getScore() - (doubled ? 1 : 0);
+
+    // reset game
+    game->reset();
+
+    // run other branches of split game
+    while (splits.size() > 0) {
+
+        // fetch split data
+        split = splits.back();
+        splits.pop_back();
+
+        // deal game
+        game->setupSplit(split.playerCard, split.dealerCard1, split.dealerCard2);
+
+        // deal player second card
+        game->hit();
+
+        // play player moves
+        // game over carries from the last hand like it always has
+        gameOver = playChartMoves(game, chart, splits, gameOver, doubled, visited);
+
+        // player dealer turn if game isn't over
+        if (!gameOver) {
+
+            game->playDealer();
+
+        }
+
+        // update balance
+        change += game->getScore() - (doubled ? 1 : 0);
+
+        // reset game
+        game->reset();
+
+    }
+
+    return change;
+
+}
+
+#endif
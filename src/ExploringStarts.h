@@ -0,0 +1,227 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: picks starting states for exploring starts training
+*/
+
+// file guards
+#ifndef EXPLORING_STARTS_H
+#define EXPLORING_STARTS_H
+
+// imports
+#include <vector>
+#include <random>
+#include <utility>
+#include <cmath>
+#include <string>
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+
+// namespace
+using std::vector, std::pair;
+using std::mt19937;
+using std::discrete_distribution, std::uniform_real_distribution, std::uniform_int_distribution;
+using std::sqrt;
+using std::string;
+
+// how training games are started
+enum StartMode {
+
+    // every game is a natural deal from the shoe
+    NATURAL_STARTS,
+
+    // some games start in a chart cell picked uniformly
+    UNIFORM_STARTS,
+
+    // some games start in a chart cell picked by weight
+    WEIGHTED_STARTS,
+
+    // some games start in a chart cell picked by how undecided it is
+    ADAPTIVE_STARTS
+
+};
+const string START_MODE_NAMES[] = {
+
+    "natural",
+    "uniform",
+    "weighted",
+    "adaptive"
+
+};
+
+// value weight of each card for picking hands like the shoe would
+// index is card value - 1, tens are four times as common
+const double CARD_WEIGHTS[DEALER_HAND_COUNT] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 4};
+
+// class to pick exploring starts states
+class StartSampler {
+
+    private:
+
+        // randomizer for all picks
+        mt19937 randomizer;
+
+        // weight of each chart cell
+        double cellWeights[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+
+        // distribution over cells built from weights
+        discrete_distribution<int> cellPicker;
+
+        // hands that land on each chart row
+        // fewest cards possible, never a natural
+        vector<vector<int>> rowHands[PLAYER_HAND_COUNT];
+
+        // distribution over hands in each row
+        discrete_distribution<int> handPickers[PLAYER_HAND_COUNT];
+
+        // rebuild cell picker from the cell weights
+        void buildCellPicker() {
+
+            // flatten weights
+            vector<double> flat;
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+                    flat.push_back(this->cellWeights[i][j]);
+
+                }
+            }
+
+            this->cellPicker = discrete_distribution<int>(flat.begin(), flat.end());
+
+        }
+
+    public:
+
+        // constructor
+        StartSampler(unsigned int seed) {
+
+            // seed randomizer
+            this->randomizer = mt19937(seed);
+
+            // find hands for each row
+            findRowHands(this->rowHands);
+
+            // weight the hands in each row by how often they are dealt
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+                vector<double> handWeights;
+                for (unsigned int h = 0; h < this->rowHands[i].size(); h ++) {
+
+                    // product of card weights
+                    double weight = 1;
+                    for (unsigned int c = 0; c < this->rowHands[i].at(h).size(); c ++) {
+
+                        weight *= CARD_WEIGHTS[this->rowHands[i].at(h).at(c) - 1];
+
+                    }
+                    handWeights.push_back(weight);
+
+                }
+
+                this->handPickers[i] = discrete_distribution<int>(handWeights.begin(), handWeights.end());
+
+            }
+
+            // start uniform
+            this->setUniform();
+
+        }
+
+        // weight every cell the same
+        void setUniform() {
+
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+                    this->cellWeights[i][j] = 1;
+
+                }
+            }
+
+            this->buildCellPicker();
+
+        }
+
+        // set custom cell weights
+        void setWeights(const double weights[][DEALER_HAND_COUNT]) {
+
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+                    this->cellWeights[i][j] = weights[i][j];
+
+                }
+            }
+
+            this->buildCellPicker();
+
+        }
+
+        // weight cells by the inverse square root of their training counts
+        // rarely updated cells get picked more
+        void setWeightsFromCounts(int (*counts)[DEALER_HAND_COUNT][ACTION_TYPE_COUNT]) {
+
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+                    // total updates across actions
+                    double cellCount = 0;
+                    for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+
+                        cellCount += counts[i][j][k];
+
+                    }
+
+                    this->cellWeights[i][j] = 1 / sqrt(1 + cellCount);
+
+                }
+            }
+
+            this->buildCellPicker();
+
+        }
+
+        // returns true with the given probability
+        bool roll(double probability) {
+
+            return uniform_real_distribution<double>(0, 1)(this->randomizer) < probability;
+
+        }
+
+        // pick a chart cell
+        // return format is pair<row/player_hand, col/dealer_hand>
+        pair<int, int> sampleCell() {
+
+            int cell = this->cellPicker(this->randomizer);
+            return pair<int, int>(cell / DEALER_HAND_COUNT, cell % DEALER_HAND_COUNT);
+
+        }
+
+        // pick player cards that land on a chart row
+        vector<int> sampleHand(int row) {
+
+            vector<int> cards = this->rowHands[row].at(this->handPickers[row](this->randomizer));
+
+            // shuffle card order so a hand isn't always low card first
+            shuffle(cards.begin(), cards.end(), this->randomizer);
+
+            return cards;
+
+        }
+
+        // pick one of the allowed actions uniformly
+        ActionType sampleAction(const vector<ActionType>& actions) {
+
+            return actions.at(uniform_int_distribution<int>(0, actions.size() - 1)(this->randomizer));
+
+        }
+
+        // get cell weights
+        double (*getWeights())[DEALER_HAND_COUNT] {
+            return this->cellWeights;
+        }
+
+};
+
+#endif
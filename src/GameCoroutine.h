@@ -0,0 +1,483 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: a hand of blackjack as a coroutine that stops at each decision the player
+             makes, and a scheduler that keeps many of them in flight on one thread and
+             answers their decisions in batches
+*/
+
+// file guards
+#ifndef GAME_COROUTINE_H
+#define GAME_COROUTINE_H
+
+// imports
+#include <vector>
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "CompiledChart.h"
+
+// namespace
+using std::vector;
+using std::coroutine_handle, std::suspend_never, std::suspend_always;
+using std::terminate;
+using std::exchange, std::swap;
+
+// bytes set aside for each hand's coroutine frame, bigger frames come straight from the heap
+const size_t HAND_FRAME_BYTES = 512;
+
+// a decision a hand is waiting on
+struct DecisionPoint {
+
+    // packed chart cell of the state, rows then columns
+    unsigned short cell;
+
+    // bit per ActionType the player is allowed to take, from legalActionMask,
+    // for answerers other than a chart that have to pick a valid action
+    unsigned char legal;
+
+    // hand still has its first two cards, packed charts keep a separate action for it
+    bool firstMove;
+
+};
+
+// decision point of a state
+DecisionPoint decisionPoint(const Hands& state) {
+
+    return {
+        static_cast<unsigned short>(compiledCellIndex(state)),
+        legalActionMask(state),
+        state.playerCards.size() == 2
+    };
+
+}
+
+// action a packed chart takes at a decision point, the same one compiledMove picks
+// the chart is followed like in direct play, so the legal mask isn't checked here
+ActionType chartAction(const CompiledChart& chart, const DecisionPoint& point) {
+
+    int shift = point.firstMove ? 0 : LATER_ACTION_SHIFT;
+
+    return static_cast<ActionType>((chart.cells[point.cell] >> shift) & ACTION_MASK);
+
+}
+
+// frames of finished hands kept for the next hands on the thread
+// once every lane of a scheduler has had a frame, starting a hand doesn't allocate
+class HandFramePool {
+
+    private:
+
+        vector<void*> frames;
+
+    public:
+
+        ~HandFramePool() {
+
+            for (void* frame : this->frames) {
+                ::operator delete(frame);
+            }
+
+        }
+
+        // has count frames ready, with room to give them all back
+        void reserve(size_t count) {
+
+            this->frames.reserve(count);
+            while (this->frames.size() < count) {
+                this->frames.push_back(::operator new(HAND_FRAME_BYTES));
+            }
+
+        }
+
+        void* take(size_t size) {
+
+            if (size > HAND_FRAME_BYTES) {
+                return ::operator new(size);
+            }
+            if (this->frames.empty()) {
+                return ::operator new(HAND_FRAME_BYTES);
+            }
+
+            void* frame = this->frames.back();
+            this->frames.pop_back();
+            return frame;
+
+        }
+
+        void give(void* frame, size_t size) {
+
+            if (size > HAND_FRAME_BYTES) {
+
+                ::operator delete(frame);
+                return;
+
+            }
+            this->frames.push_back(frame);
+
+        }
+
+};
+thread_local HandFramePool handFramePool;
+
+// a hand being played, stopped at a decision or finished with its balance change
+class HandCoroutine {
+
+    public:
+
+        struct promise_type;
+
+        // what co_yield of a decision point waits on, gives back the action it was answered with
+        struct ActionAwaiter {
+
+            promise_type* promise;
+
+            bool await_ready() noexcept {
+                return false;
+            }
+
+            void await_suspend(coroutine_handle<>) noexcept {
+            }
+
+            ActionType await_resume() noexcept {
+                return this->promise->action;
+            }
+
+        };
+
+        struct promise_type {
+
+            DecisionPoint decision;
+            ActionType action;
+            double change;
+
+            HandCoroutine get_return_object() {
+                return HandCoroutine(coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            // deals and plays up to the first decision as soon as it's made
+            suspend_never initial_suspend() noexcept {
+                return {};
+            }
+
+            // kept after the hand ends so the change can be read
+            suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            ActionAwaiter yield_value(const DecisionPoint& point) {
+
+                this->decision = point;
+                return {this};
+
+            }
+
+            void return_value(double change) {
+                this->change = change;
+            }
+
+            void unhandled_exception() {
+                terminate();
+            }
+
+            // frames come from the thread's pool
+            static void* operator new(size_t size) {
+                return handFramePool.take(size);
+            }
+
+            static void operator delete(void* frame, size_t size) {
+                handFramePool.give(frame, size);
+            }
+
+        };
+
+    private:
+
+        coroutine_handle<promise_type> handle;
+
+    public:
+
+        HandCoroutine() {
+
+            this->handle = nullptr;
+
+        }
+
+        HandCoroutine(coroutine_handle<promise_type> handle) {
+
+            this->handle = handle;
+
+        }
+
+        HandCoroutine(HandCoroutine&& other) noexcept {
+
+            this->handle = exchange(other.handle, nullptr);
+
+        }
+
+        HandCoroutine& operator=(HandCoroutine&& other) noexcept {
+
+            if (this != &other) {
+
+                this->clear();
+                this->handle = exchange(other.handle, nullptr);
+
+            }
+            return *this;
+
+        }
+
+        HandCoroutine(const HandCoroutine&) = delete;
+        HandCoroutine& operator=(const HandCoroutine&) = delete;
+
+        ~HandCoroutine() {
+
+            this->clear();
+
+        }
+
+        // lets go of the hand, its frame goes back to the pool
+        void clear() {
+
+            if (this->handle) {
+
+                this->handle.destroy();
+                this->handle = nullptr;
+
+            }
+
+        }
+
+        bool isWaiting() const {
+            return this->handle && !this->handle.done();
+        }
+
+        bool isDone() const {
+            return this->handle && this->handle.done();
+        }
+
+        const DecisionPoint& getDecision() const {
+            return this->handle.promise().decision;
+        }
+
+        // plays on from the decision with an action until the next decision or the end
+        void answer(ActionType action) {
+
+            this->handle.promise().action = action;
+            this->handle.resume();
+
+        }
+
+        // balance change in bets of a finished hand
+        double getChange() const {
+            return this->handle.promise().change;
+        }
+
+};
+
+// plays a dealt hand and every split branch, stopping at each decision for an action
+// returns the balance change in bets the same way playChartHand counts it
+// game and splits belong to the hand until it finishes
+HandCoroutine playHandCoroutine(Game* game, vector<SplitInfo>& splits) {
+
+    // balance change in bets
+    double change = 0;
+
+    // player doubled the current hand
+    bool doubled;
+
+    // split branch being played or set up
+    SplitInfo split;
+
+    // deal game, then play the first hand and every split branch the same way
+    bool gameOver = game->dealHands();
+    while (true) {
+
+        // player moves until they stand, double or the game ends
+        ActionType agentMove = HIT;
+        doubled = false;
+        while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
+
+            agentMove = co_yield decisionPoint(game->getState());
+
+            switch (agentMove) {
+
+                case HIT:
+
+                    gameOver = game->hit();
+                    break;
+
+                case SPLIT:
+
+                    // other side is played after this one
+                    split = {
+                        game->getState().playerCards.at(0),
+                        game->getState().dealerShowing,
+                        game->getDealerSecondCard()
+                    };
+                    splits.push_back(split);
+                    game->runSplit();
+                    break;
+
+                case DOUBLE:
+
+                    game->doubleBet();
+                    doubled = true;
+                    gameOver = game->hit();
+                    break;
+
+                default:
+
+                    break;
+
+            }
+
+        }
+
+        // player dealer turn if game isn't over
+        if (!gameOver) {
+
+            game->playDealer();
+
+        }
+
+        // update balance and reset game
+        change += game->getScore() - (doubled ? 1 : 0);
+        game->reset();
+
+        // next split branch, game over carries from the last hand like it always has
+        if (splits.empty()) {
+            break;
+        }
+        split = splits.back();
+        splits.pop_back();
+        game->setupSplit(split.playerCard, split.dealerCard1, split.dealerCard2);
+        game->hit();
+
+    }
+
+    co_return change;
+
+}
+
+// keeps one hand per lane in flight and answers every waiting hand's decision in a batch,
+// all the chart lookups of a batch happen before any hand plays on
+class HandScheduler {
+
+    private:
+
+        // each lane's hand and the chart answering it
+        vector<HandCoroutine> hands;
+        vector<const CompiledChart*> charts;
+
+        // lanes waiting on a decision, and those still waiting after a batch
+        vector<int> waiting;
+        vector<int> stillWaiting;
+        vector<ActionType> answers;
+
+        long long decisions;
+        long long batches;
+
+        // hands off a lane's finished hands and starts new ones until one waits on a decision
+        // or the lane has no more hands
+        template <typename NextHand, typename FinishHand>
+        void advance(int lane, NextHand& nextHand, FinishHand& finishHand) {
+
+            HandCoroutine& hand = this->hands[lane];
+            while (true) {
+
+                if (hand.isWaiting()) {
+
+                    this->stillWaiting.push_back(lane);
+                    return;
+
+                }
+
+                if (hand.isDone()) {
+
+                    finishHand(lane, hand.getChange());
+                    hand.clear();
+
+                }
+
+                if (!nextHand(lane, hand, this->charts[lane])) {
+                    return;
+                }
+
+            }
+
+        }
+
+    public:
+
+        HandScheduler(int laneCount) {
+
+            this->hands = vector<HandCoroutine>(laneCount);
+            this->charts = vector<const CompiledChart*>(laneCount, nullptr);
+            this->waiting.reserve(laneCount);
+            this->stillWaiting.reserve(laneCount);
+            this->answers = vector<ActionType>(laneCount);
+            this->decisions = 0;
+            this->batches = 0;
+
+            // a frame for every lane's hand, so warmed up lanes don't allocate
+            handFramePool.reserve(laneCount);
+
+        }
+
+        // plays every lane's hands until none has more
+        // nextHand(lane, hand, chart) sets the lane's next hand and the chart that answers it,
+        // returning false once the lane is done, and finishHand(lane, change) gets each
+        // finished hand's balance change, both are called in the order a lane plays its hands
+        template <typename NextHand, typename FinishHand>
+        void run(NextHand nextHand, FinishHand finishHand) {
+
+            this->stillWaiting.clear();
+            for (int lane = 0; lane < static_cast<int>(this->hands.size()); lane ++) {
+                this->advance(lane, nextHand, finishHand);
+            }
+            swap(this->waiting, this->stillWaiting);
+
+            while (!this->waiting.empty()) {
+
+                // answer the batch
+                const int BATCH_SIZE = this->waiting.size();
+                for (int w = 0; w < BATCH_SIZE; w ++) {
+
+                    int lane = this->waiting[w];
+                    this->answers[w] = chartAction(*this->charts[lane], this->hands[lane].getDecision());
+
+                }
+                this->decisions += BATCH_SIZE;
+                this->batches ++;
+
+                // play each hand on to its next decision
+                this->stillWaiting.clear();
+                for (int w = 0; w < BATCH_SIZE; w ++) {
+
+                    int lane = this->waiting[w];
+                    this->hands[lane].answer(this->answers[w]);
+                    this->advance(lane, nextHand, finishHand);
+
+                }
+                swap(this->waiting, this->stillWaiting);
+
+            }
+
+        }
+
+        long long getDecisionCount() const {
+            return this->decisions;
+        }
+
+        long long getBatchCount() const {
+            return this->batches;
+        }
+
+};
+
+#endif
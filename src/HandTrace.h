@@ -0,0 +1,379 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: per hand traces of an eval, the chart cells each hand read and the cards it
+             was dealt from, so an edited chart can be evaluated again by replaying only the
+             hands that read an edited cell and keeping the rest of the results
+*/
+
+// file guards
+#ifndef HAND_TRACE_H
+#define HAND_TRACE_H
+
+// imports
+#include <string>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include "BlackJack.h"
+#include "CompiledChart.h"
+#include "Eval.h"
+
+// namespace
+using std::string;
+using std::ofstream, std::ifstream;
+using std::ios;
+using std::vector;
+using std::lround;
+using std::memcpy, std::memset;
+using std::min;
+
+// file layout, all numbers little endian as this machine writes them
+//   header   HandTraceHeader, the settings and chart the hands were played with
+//   rounds   RoundTrace then its HandTrace entries, the cell of each of their decisions
+//            (2 bytes each) and the cards dealt in the round, two to a byte
+const uint32_t HAND_TRACE_MAGIC = 0x43415254; // "TRAC"
+const uint32_t HAND_TRACE_VERSION = 1;
+
+// cards recorded past the end of every round, so a replayed hand that takes more cards
+// than it did still has cards to deal, far more than a hand and all its splits can use
+const int TAPE_TAIL_CARDS = 256;
+
+// decks a replay dealer goes without reshuffling, more than a loaded shoe ever holds
+const int REPLAY_SHOE_DECKS = 100;
+
+// settings the hands were played with, replays need the same ones
+struct HandTraceHeader {
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t seed;
+    uint32_t rounds;
+    uint32_t gamesPerRound;
+    uint32_t deckCount;
+    uint32_t shuffleEveryNDecks;
+    uint32_t reserved;
+    double startingBalance;
+    Scoring payouts;
+    unsigned char chart[COMPILED_CHART_SIZE];
+
+};
+
+// a round's sizes, its hands, cells and cards follow it
+struct RoundTrace {
+
+    uint32_t hands;
+    uint32_t cells;
+    uint32_t tapeCards;
+
+};
+
+// a hand in the order it was played
+struct HandTrace {
+
+    // cards dealt for the hand and its splits
+    uint8_t cards;
+
+    // balance change in half bets, every payout is a multiple of half a bet
+    int8_t halfBets;
+
+    // chart cells its decisions read
+    uint8_t cellCount;
+
+};
+
+// trace of the rounds a chunk plays, filled in as they're played
+class ChunkTrace {
+
+    private:
+
+        vector<RoundTrace> rounds;
+        vector<HandTrace> hands;
+        vector<unsigned short> cells;
+        vector<unsigned char> tape;
+
+        // where the current round and hand started
+        size_t roundHands;
+        size_t roundCells;
+        size_t roundTape;
+        size_t handCells;
+        size_t handTape;
+
+        // false once a hand didn't fit its trace entry
+        bool fits;
+
+    public:
+
+        ChunkTrace() {
+
+            this->roundHands = 0;
+            this->roundCells = 0;
+            this->roundTape = 0;
+            this->handCells = 0;
+            this->handTape = 0;
+            this->fits = true;
+
+        }
+
+        // cells list the hand player adds decisions to
+        vector<unsigned short>* getVisited() {
+            return &this->cells;
+        }
+
+        bool allFit() const {
+            return this->fits;
+        }
+
+        // starts recording a round the dealer has just shuffled for
+        void startRound(Dealer* dealer) {
+
+            this->roundHands = this->hands.size();
+            this->roundCells = this->cells.size();
+            this->roundTape = this->tape.size();
+            dealer->setTape(&this->tape);
+
+        }
+
+        void startHand() {
+
+            this->handCells = this->cells.size();
+            this->handTape = this->tape.size();
+
+        }
+
+        // adds the hand just played
+        void endHand(double change) {
+
+            long halfBets = lround(2 * change);
+            size_t cardCount = this->tape.size() - this->handTape;
+            size_t cellCount = this->cells.size() - this->handCells;
+            if (halfBets != 2 * change || halfBets < INT8_MIN || halfBets > INT8_MAX || cardCount > UINT8_MAX || cellCount > UINT8_MAX) {
+                this->fits = false;
+            }
+
+            this->hands.push_back({static_cast<uint8_t>(cardCount), static_cast<int8_t>(halfBets), static_cast<uint8_t>(cellCount)});
+
+        }
+
+        // stops recording and adds the cards the shoe would have dealt next
+        // they come from a copy of the dealer so the rounds after play the same either way
+        void endRound(Dealer* dealer) {
+
+            dealer->setTape(nullptr);
+            Dealer next = *dealer;
+            for (int c = 0; c < TAPE_TAIL_CARDS; c ++) {
+                this->tape.push_back(next.deal());
+            }
+
+            this->rounds.push_back({
+                static_cast<uint32_t>(this->hands.size() - this->roundHands),
+                static_cast<uint32_t>(this->cells.size() - this->roundCells),
+                static_cast<uint32_t>(this->tape.size() - this->roundTape)
+            });
+
+        }
+
+        // writes the chunk's rounds in the order they were played
+        void write(ofstream& outfile) const {
+
+            size_t hand = 0;
+            size_t cell = 0;
+            size_t card = 0;
+            vector<unsigned char> packed;
+            for (const RoundTrace& round : this->rounds) {
+
+                outfile.write(reinterpret_cast<const char*>(&round), sizeof(round));
+                outfile.write(reinterpret_cast<const char*>(this->hands.data() + hand), round.hands * sizeof(HandTrace));
+                outfile.write(reinterpret_cast<const char*>(this->cells.data() + cell), round.cells * sizeof(unsigned short));
+
+                // cards are 1 to 10, two fit in a byte
+                packed.assign((round.tapeCards + 1) / 2, 0);
+                for (uint32_t c = 0; c < round.tapeCards; c ++) {
+                    packed[c / 2] |= this->tape[card + c] << (4 * (c % 2));
+                }
+                outfile.write(reinterpret_cast<const char*>(packed.data()), packed.size());
+
+                hand += round.hands;
+                cell += round.cells;
+                card += round.tapeCards;
+
+            }
+
+        }
+
+};
+
+// starts a trace file with the settings and chart the hands are played with
+HandTraceHeader newTraceHeader(unsigned int seed, int rounds, int gamesPerRound, int deckCount, int shuffleEveryNDecks, double startingBalance, const Scoring& payouts, const CompiledChart& chart) {
+
+    HandTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = HAND_TRACE_MAGIC;
+    header.version = HAND_TRACE_VERSION;
+    header.seed = seed;
+    header.rounds = rounds;
+    header.gamesPerRound = gamesPerRound;
+    header.deckCount = deckCount;
+    header.shuffleEveryNDecks = shuffleEveryNDecks;
+    header.startingBalance = startingBalance;
+    header.payouts = payouts;
+    memcpy(header.chart, chart.cells, COMPILED_CHART_SIZE);
+
+    return header;
+
+}
+
+// writes the header and every chunk's rounds in chunk order
+bool writeHandTrace(const string& path, const HandTraceHeader& header, const vector<ChunkTrace>& chunks) {
+
+    ofstream outfile(path, ios::binary);
+    outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const ChunkTrace& chunk : chunks) {
+        chunk.write(outfile);
+    }
+
+    return outfile.good();
+
+}
+
+// an eval's hand trace read back, for replaying its hands with another chart
+class HandTraceReader {
+
+    private:
+
+        vector<unsigned char> data;
+        HandTraceHeader header;
+
+        // where each round's RoundTrace starts
+        vector<size_t> roundOffsets;
+
+    public:
+
+        // reads a trace and finds its rounds
+        // returns false and says why if it can't be read
+        bool open(const string& path, string& error) {
+
+            ifstream infile(path, ios::binary);
+            if (!infile.is_open()) {
+
+                error = "can't open " + path;
+                return false;
+
+            }
+            infile.seekg(0, ios::end);
+            this->data.resize(infile.tellg());
+            infile.seekg(0);
+            infile.read(reinterpret_cast<char*>(this->data.data()), this->data.size());
+
+            if (this->data.size() < sizeof(HandTraceHeader)) {
+
+                error = path + " is too short to be a hand trace";
+                return false;
+
+            }
+            memcpy(&this->header, this->data.data(), sizeof(this->header));
+            if (this->header.magic != HAND_TRACE_MAGIC || this->header.version != HAND_TRACE_VERSION) {
+
+                error = path + " isn't a version " + std::to_string(HAND_TRACE_VERSION) + " hand trace";
+                return false;
+
+            }
+
+            size_t offset = sizeof(HandTraceHeader);
+            for (uint32_t r = 0; r < this->header.rounds; r ++) {
+
+                RoundTrace round;
+                if (offset + sizeof(round) > this->data.size()) {
+                    break;
+                }
+                memcpy(&round, this->data.data() + offset, sizeof(round));
+                this->roundOffsets.push_back(offset);
+                offset += sizeof(round) + round.hands * sizeof(HandTrace) + round.cells * sizeof(unsigned short) + (round.tapeCards + 1) / 2;
+
+            }
+            if (offset != this->data.size() || this->roundOffsets.size() != this->header.rounds) {
+
+                error = path + " is cut short or has extra data";
+                return false;
+
+            }
+
+            return true;
+
+        }
+
+        const HandTraceHeader& getHeader() const {
+            return this->header;
+        }
+
+        int getRoundCount() const {
+            return this->roundOffsets.size();
+        }
+
+        // balance change of every hand of a round with another chart
+        // hands that read a changed cell are played again from the cards they started on,
+        // the rest would make the same choices on the same cards so their change is kept
+        // the dealer should be a replay dealer, counts the hands played again in replayed
+        void replayRound(int r, const CompiledChart& chart, const vector<bool>& changed, Game* game, Dealer* dealer, vector<SplitInfo>& splits, vector<double>& changes, long long& replayed) const {
+
+            RoundTrace round;
+            const unsigned char* at = this->data.data() + this->roundOffsets.at(r);
+            memcpy(&round, at, sizeof(round));
+            const HandTrace* hands = reinterpret_cast<const HandTrace*>(at + sizeof(round));
+            const unsigned char* cellBytes = at + sizeof(round) + round.hands * sizeof(HandTrace);
+            const unsigned char* packed = cellBytes + round.cells * sizeof(unsigned short);
+
+            // round's cards, only unpacked if a hand needs them
+            vector<unsigned char> cards;
+
+            changes.clear();
+            uint32_t cell = 0;
+            uint32_t card = 0;
+            for (uint32_t h = 0; h < round.hands; h ++) {
+
+                // did the hand read a changed cell
+                bool replay = false;
+                for (int c = 0; c < hands[h].cellCount; c ++) {
+
+                    unsigned short index;
+                    memcpy(&index, cellBytes + (cell + c) * sizeof(unsigned short), sizeof(index));
+                    replay = replay || changed[index];
+
+                }
+
+                if (replay) {
+
+                    if (cards.empty()) {
+
+                        cards.resize(round.tapeCards);
+                        for (uint32_t c = 0; c < round.tapeCards; c ++) {
+                            cards[c] = (packed[c / 2] >> (4 * (c % 2))) & 0xf;
+                        }
+
+                    }
+
+                    // the tail means there are always at least this many left
+                    dealer->loadShoe(cards.data() + card, min<uint32_t>(round.tapeCards - card, TAPE_TAIL_CARDS));
+                    changes.push_back(playChartHand(game, chart, splits));
+                    replayed ++;
+
+                }
+                else {
+
+                    changes.push_back(hands[h].halfBets / 2.0);
+
+                }
+
+                cell += hands[h].cellCount;
+                card += hands[h].cards;
+
+            }
+
+        }
+
+};
+
+#endif
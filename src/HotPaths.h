@@ -0,0 +1,341 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: the simulator's hot path benchmarks, shared by bench and perfcheck
+*/
+
+// file guards
+#ifndef HOT_PATHS_H
+#define HOT_PATHS_H
+
+// imports
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include "Bench.h"
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "ExploringStarts.h"
+#include "Training.h"
+#include "Solver.h"
+#include "ChartIO.h"
+#include "CompiledChart.h"
+#include "Eval.h"
+#include "Betting.h"
+
+// namespace
+using std::string;
+using std::vector;
+using std::exp;
+using std::srand;
+
+// CONSTANT BENCHMARK PARAMETERS
+const double DEFAULT_WARMUP_SECONDS = 0.2;
+const double DEFAULT_REPETITION_SECONDS = 0.1;
+const int DEFAULT_REPETITIONS = 10;
+const unsigned int BENCH_SEED = 42;
+
+// games dealt ahead of time for benchmarks of a single step of a game
+const int GAME_BATCH = 256;
+
+// states looked up by the table and agent benchmarks
+const int STATE_COUNT = 1024;
+
+// same game as driver and eval
+const int DECK_COUNT = 4;
+const int SHUFFLE_EVERY_N_DECKS = 2;
+const Scoring SCORES = {
+
+    1.5,  // blackjack;
+    2,    // doubleWin;
+    1,    // win;
+    -1,   // loss;
+    -2,   // doubleLoss;
+    0     // push;
+
+};
+
+// same training setup as driver
+const double E_COEFFICIENT = 6e-7;
+const double E_RIGHT_SHIFT = 4;
+const auto EPSILON = [](int x) -> double {return (1 / (1 + exp(E_COEFFICIENT*x - E_RIGHT_SHIFT)));};
+const float GAMMA = 1.0;
+const float ALPHA = 4e-3;
+const int TRAIN_EVERY = 2000;
+
+// same round as eval
+const int ROUND_GAMES = 1000;
+const double STARTING_BAL = 1000;
+const double M = 2;
+
+// deals every game in a batch until none of them are over from naturals
+void dealBatch(vector<Game>& games) {
+
+    for (Game& game : games) {
+
+        game.reset();
+        while (game.dealHands()) {
+            game.reset();
+        }
+
+    }
+
+}
+
+// infinite deck exact chart, played by the round benchmarks
+void compileSolvedChart(CompiledChart& compiled) {
+
+    StrategySolver solver(SCORES, 0);
+    solver.solve();
+    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+    buildChart(solver.getQTable(), chart);
+    compileChart(chart, compiled);
+
+}
+
+// runs every hot path benchmark with filter in its name, or all of them for an empty filter
+vector<BenchResult> runHotPathBenchmarks(const BenchConfig& config, const string& filter) {
+
+    // shared setup
+    Dealer dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, BENCH_SEED);
+    Game game(&dealer, SCORES);
+    vector<Game> games(GAME_BATCH, Game(&dealer, SCORES));
+    vector<SplitInfo> splits;
+
+    // live states to look up, as the player sees them on their first move
+    vector<Hands> states;
+    while (static_cast<int>(states.size()) < STATE_COUNT) {
+
+        if (!game.dealHands()) {
+            states.push_back(game.getState());
+        }
+        game.reset();
+
+    }
+
+    // exact chart for the round benchmark
+    CompiledChart compiled;
+    compileSolvedChart(compiled);
+
+    // agent and starts for the training benchmarks
+    BlackJackAgent agent(EPSILON, GAMMA, ALPHA);
+    StartSampler sampler(BENCH_SEED);
+    srand(BENCH_SEED);
+
+    vector<BenchResult> results;
+    auto wanted = [&](const string& name) -> bool {
+        return filter.empty() || name.find(filter) != string::npos;
+    };
+
+    // one card off the shoe, with the reshuffle every two decks
+    if (wanted("Dealer::deal")) {
+
+        results.push_back(runBenchmark("Dealer::deal", config, "cards", 1, [&](BenchState& state) {
+
+            int sum = 0;
+            for (long long i = 0; i < state.getIterations(); i ++) {
+                sum += dealer.deal();
+            }
+            doNotOptimize(sum);
+
+        }));
+
+    }
+
+    // fresh shuffled shoe
+    if (wanted("Dealer::reshuffle")) {
+
+        Dealer shoe(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, BENCH_SEED);
+        results.push_back(runBenchmark("Dealer::reshuffle", config, "shoes", 1, [&](BenchState& state) {
+
+            for (long long i = 0; i < state.getIterations(); i ++) {
+                shoe.reshuffle();
+            }
+
+        }));
+
+    }
+
+    // starting hands, with the reset a game needs before the next deal
+    if (wanted("Game::dealHands")) {
+
+        results.push_back(runBenchmark("Game::dealHands+reset", config, "hands", 1, [&](BenchState& state) {
+
+            bool over = false;
+            for (long long i = 0; i < state.getIterations(); i ++) {
+
+                over ^= game.dealHands();
+                game.reset();
+
+            }
+            doNotOptimize(over);
+
+        }));
+
+    }
+
+    // one hit on a freshly dealt hand, the deals are left out of the timing
+    if (wanted("Game::hit")) {
+
+        results.push_back(runBenchmark("Game::hit", config, "hits", 1, [&](BenchState& state) {
+
+            bool over = false;
+            for (long long done = 0; done < state.getIterations(); done += GAME_BATCH) {
+
+                state.pauseTiming();
+                dealBatch(games);
+                state.resumeTiming();
+
+                for (long long g = 0; g < GAME_BATCH && done + g < state.getIterations(); g ++) {
+                    over ^= games[g].hit();
+                }
+
+            }
+            doNotOptimize(over);
+
+        }));
+
+    }
+
+    // dealer's turn on a freshly dealt hand, the deals are left out of the timing
+    if (wanted("Game::playDealer")) {
+
+        results.push_back(runBenchmark("Game::playDealer", config, "hands", 1, [&](BenchState& state) {
+
+            double score = 0;
+            for (long long done = 0; done < state.getIterations(); done += GAME_BATCH) {
+
+                state.pauseTiming();
+                dealBatch(games);
+                state.resumeTiming();
+
+                for (long long g = 0; g < GAME_BATCH && done + g < state.getIterations(); g ++) {
+
+                    games[g].playDealer();
+                    score += games[g].getScore();
+
+                }
+
+            }
+            doNotOptimize(score);
+
+        }));
+
+    }
+
+    // q table coordinates of a state
+    if (wanted("getTableIndex")) {
+
+        results.push_back(runBenchmark("getTableIndex", config, "lookups", 1, [&](BenchState& state) {
+
+            int sum = 0;
+            for (long long i = 0; i < state.getIterations(); i ++) {
+
+                pair<int, int> coords = getTableIndex(states[i % STATE_COUNT]);
+                sum += coords.first + coords.second;
+
+            }
+            doNotOptimize(sum);
+
+        }));
+
+    }
+
+    // agent's pick for a state, the recorded move history is cleared outside the timing
+    if (wanted("BlackJackAgent::makeMove")) {
+
+        results.push_back(runBenchmark("BlackJackAgent::makeMove", config, "moves", 1, [&](BenchState& state) {
+
+            int sum = 0;
+            for (long long done = 0; done < state.getIterations(); done += STATE_COUNT) {
+
+                state.pauseTiming();
+                agent.clearGameActions();
+                state.resumeTiming();
+
+                for (long long s = 0; s < STATE_COUNT && done + s < state.getIterations(); s ++) {
+                    sum += agent.makeMove(states[s]);
+                }
+
+            }
+            doNotOptimize(sum);
+
+        }));
+        agent.clearGameActions();
+
+    }
+
+    // one training game with its splits, as driver plays them
+    if (wanted("playTrainingGame")) {
+
+        results.push_back(runBenchmark("playTrainingGame", config, "games", 1, [&](BenchState& state) {
+
+            for (long long i = 0; i < state.getIterations(); i ++) {
+                playTrainingGame(&game, &agent, &sampler, NATURAL_STARTS, 0, splits);
+            }
+
+            // training examples are dropped outside the timing
+            state.pauseTiming();
+            agent.train();
+            state.resumeTiming();
+
+        }));
+
+    }
+
+    // one q table update over the games driver plays between updates, the games are left out of the timing
+    if (wanted("BlackJackAgent::train")) {
+
+        results.push_back(runBenchmark("BlackJackAgent::train", config, "games", TRAIN_EVERY, [&](BenchState& state) {
+
+            for (long long i = 0; i < state.getIterations(); i ++) {
+
+                state.pauseTiming();
+                for (int g = 0; g < TRAIN_EVERY; g ++) {
+                    playTrainingGame(&game, &agent, &sampler, NATURAL_STARTS, 0, splits);
+                }
+                state.resumeTiming();
+
+                agent.train();
+
+            }
+
+        }));
+
+    }
+
+    // full eval round of hands played by chart with a constant bet
+    if (wanted("round")) {
+
+        vector<BettingStrategy> strategies = {{CONSTANT_BETTING, 0, M, 0, 0, 0}};
+        BankrollTracks tracks(strategies);
+        results.push_back(runBenchmark("eval round", config, "hands", ROUND_GAMES, [&](BenchState& state) {
+
+            double balance = 0;
+            for (long long i = 0; i < state.getIterations(); i ++) {
+
+                dealer.reshuffle();
+                tracks.startRound(STARTING_BAL);
+                for (int gameNum = 0; gameNum < ROUND_GAMES; gameNum ++) {
+
+                    if (!tracks.placeBets(gameNum, 1)) {
+                        break;
+                    }
+                    tracks.settle(playChartHand(&game, compiled, splits));
+
+                }
+                balance += tracks.getBalance(0);
+
+            }
+            doNotOptimize(balance);
+
+        }));
+
+    }
+
+    return results;
+
+}
+
+#endif
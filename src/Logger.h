@@ -0,0 +1,117 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: logger that hands lines to a background thread so printing never blocks the caller
+*/
+
+// file guards
+#ifndef LOGGER_H
+#define LOGGER_H
+
+// imports
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <iostream>
+
+// namespace
+using std::string;
+using std::vector;
+using std::thread;
+using std::mutex, std::lock_guard, std::unique_lock;
+using std::condition_variable;
+using std::ostream;
+
+// lines are queued under a lock and written and flushed by a background thread,
+// so the caller never waits on the terminal
+// everything queued is written before the logger is destroyed
+class AsyncLogger {
+
+    private:
+
+        // where lines go
+        ostream* out;
+
+        // lines waiting to be written
+        vector<string> pending;
+
+        // queue lock and wake up for the writer
+        mutex lock;
+        condition_variable ready;
+        bool stopping;
+
+        // writer thread
+        thread writer;
+
+        // writes queued lines until stopped and empty
+        void writeLoop() {
+
+            vector<string> lines;
+            while (true) {
+
+                // take everything queued
+                {
+                    unique_lock<mutex> guard(this->lock);
+                    this->ready.wait(guard, [this] {
+                        return this->stopping || !this->pending.empty();
+                    });
+                    if (this->pending.empty() && this->stopping) {
+                        return;
+                    }
+                    lines.swap(this->pending);
+                }
+
+                // write outside the lock
+                for (const string& line : lines) {
+                    *this->out << line << '\n';
+                }
+                this->out->flush();
+                lines.clear();
+
+            }
+
+        }
+
+    public:
+
+        // constructor
+        AsyncLogger(ostream& out) {
+
+            this->out = &out;
+            this->stopping = false;
+            this->writer = thread(&AsyncLogger::writeLoop, this);
+
+        }
+
+        // destructor, writes what is left
+        ~AsyncLogger() {
+
+            {
+                lock_guard<mutex> guard(this->lock);
+                this->stopping = true;
+            }
+            this->ready.notify_one();
+            this->writer.join();
+
+        }
+
+        // no copies, the writer thread holds this
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        // queue a line
+        void log(const string& line) {
+
+            {
+                lock_guard<mutex> guard(this->lock);
+                this->pending.push_back(line);
+            }
+            this->ready.notify_one();
+
+        }
+
+};
+
+#endif
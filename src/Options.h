@@ -0,0 +1,90 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: reads --name=value options from the command line
+*/
+
+// file guards
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+// imports
+#include <string>
+#include <cstdlib>
+
+// namespace
+using std::string;
+using std::atof, std::atoi;
+
+// finds an option given as --name=value or --name value
+// returns false and leaves value alone if it isn't there
+bool readOption(int argc, char* argv[], const string& name, string& value) {
+
+    // option prefix
+    const string flag = "--" + name;
+
+    for (int i = 1; i < argc; i ++) {
+
+        string arg = argv[i];
+
+        // --name=value
+        if (arg.compare(0, flag.size() + 1, flag + "=") == 0) {
+
+            value = arg.substr(flag.size() + 1);
+            return true;
+
+        }
+
+        // --name value
+        if (arg == flag && i + 1 < argc) {
+
+            value = argv[i + 1];
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+// returns true if a bare --name flag is given
+bool hasFlag(int argc, char* argv[], const string& name) {
+
+    for (int i = 1; i < argc; i ++) {
+
+        if (string(argv[i]) == "--" + name) {
+            return true;
+        }
+
+    }
+
+    return false;
+
+}
+
+// number option with a default
+double readNumberOption(int argc, char* argv[], const string& name, double fallback) {
+
+    string value;
+    return readOption(argc, argv, name, value) ? atof(value.c_str()) : fallback;
+
+}
+
+// finds the index of a name in a list of names, -1 if missing
+int findName(const string names[], int nameCount, const string& name) {
+
+    for (int i = 0; i < nameCount; i ++) {
+
+        if (names[i] == name) {
+            return i;
+        }
+
+    }
+
+    return -1;
+
+}
+
+#endif
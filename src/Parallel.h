@@ -0,0 +1,75 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: runs numbered work chunks on a pool of threads
+*/
+
+// file guards
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// imports
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <functional>
+#include "Trace.h"
+
+// namespace
+using std::thread;
+using std::atomic;
+using std::vector;
+using std::function;
+
+// number of threads to use when none is asked for
+int defaultThreadCount() {
+
+    int count = thread::hardware_concurrency();
+    return (count > 0) ? count : 1;
+
+}
+
+// runs work(chunk, worker) for every chunk from 0 to chunkCount - 1
+// workers take the next chunk as they free up, so chunks finish in any order
+// results should be stored by chunk and combined in chunk order afterward
+void runChunks(int chunkCount, int workerCount, const function<void(int, int)>& work) {
+
+    // next chunk to hand out
+    atomic<int> nextChunk(0);
+
+    // worker loop
+    auto worker = [&](int workerIndex) {
+
+        for (int chunk = nextChunk ++; chunk < chunkCount; chunk = nextChunk ++) {
+
+            BJ_TRACE_ZONE_ARG("chunk", chunk);
+            work(chunk, workerIndex);
+
+        }
+
+    };
+
+    // run on this thread if there is only one worker
+    if (workerCount <= 1) {
+
+        worker(0);
+        return;
+
+    }
+
+    // start workers and wait for them
+    vector<thread> workers;
+    for (int w = 0; w < workerCount; w ++) {
+
+        workers.push_back(thread(worker, w));
+
+    }
+    for (unsigned int w = 0; w < workers.size(); w ++) {
+
+        workers.at(w).join();
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,203 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: rate limited training progress with throughput, eta and time spent in each phase
+*/
+
+// file guards
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+// imports
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include "Logger.h"
+
+// namespace
+using std::string;
+using std::stringstream;
+using std::ostream, std::endl;
+using std::fixed, std::setprecision, std::setw, std::setfill;
+using std::chrono::steady_clock, std::chrono::duration;
+
+// parts of a training run that time is split between
+enum TrainingPhase {SIMULATION_PHASE, TRAINING_PHASE};
+const int TRAINING_PHASE_COUNT = 2;
+const string TRAINING_PHASE_NAMES[] = {"simulation", "train"};
+
+// rate with k, M or G for big numbers
+string shortRate(double rate) {
+
+    stringstream text;
+    text << fixed << setprecision(1);
+    if (rate >= 1e9) {
+        text << rate / 1e9 << "G";
+    }
+    else if (rate >= 1e6) {
+        text << rate / 1e6 << "M";
+    }
+    else if (rate >= 1e3) {
+        text << rate / 1e3 << "k";
+    }
+    else {
+        text << rate;
+    }
+
+    return text.str();
+
+}
+
+// seconds as h:mm:ss
+string clockTime(double seconds) {
+
+    long long whole = (seconds > 0) ? static_cast<long long>(seconds + 0.5) : 0;
+    stringstream text;
+    text << whole / 3600 << ":" << setw(2) << setfill('0') << (whole / 60) % 60 << ":" << setw(2) << setfill('0') << whole % 60;
+
+    return text.str();
+
+}
+
+// tracks a training run's phases and logs a progress line at most once per interval
+// the caller only reads the clock when it switches phase or reports, never per game
+class TrainingProgress {
+
+    private:
+
+        // where progress lines go
+        AsyncLogger* logger;
+
+        // games in the whole run and seconds between progress lines
+        long long totalGames;
+        double intervalSeconds;
+
+        // run start, current phase start and last progress line
+        steady_clock::time_point start;
+        steady_clock::time_point phaseStart;
+        steady_clock::time_point lastReport;
+
+        // phase being timed and time spent in each
+        TrainingPhase phase;
+        double phaseSeconds[TRAINING_PHASE_COUNT];
+
+        // games and decisions at the last progress line
+        long long lastGames;
+        long long lastDecisions;
+
+        // games and decisions at the end of the run
+        long long finalGames;
+        long long finalDecisions;
+        double totalSeconds;
+
+        // seconds since a time
+        double secondsSince(steady_clock::time_point from, steady_clock::time_point now) const {
+            return duration<double>(now - from).count();
+        }
+
+    public:
+
+        // constructor, starts the clock in the simulation phase
+        TrainingProgress(AsyncLogger* logger, long long totalGames, double intervalSeconds) {
+
+            this->logger = logger;
+            this->totalGames = totalGames;
+            this->intervalSeconds = intervalSeconds;
+            this->start = steady_clock::now();
+            this->phaseStart = this->start;
+            this->lastReport = this->start;
+            this->phase = SIMULATION_PHASE;
+            for (int p = 0; p < TRAINING_PHASE_COUNT; p ++) {
+                this->phaseSeconds[p] = 0;
+            }
+            this->lastGames = 0;
+            this->lastDecisions = 0;
+            this->finalGames = 0;
+            this->finalDecisions = 0;
+            this->totalSeconds = 0;
+
+        }
+
+        // end the current phase and start timing another
+        void startPhase(TrainingPhase phase) {
+
+            steady_clock::time_point now = steady_clock::now();
+            this->phaseSeconds[this->phase] += this->secondsSince(this->phaseStart, now);
+            this->phaseStart = now;
+            this->phase = phase;
+
+        }
+
+        // logs a progress line if the interval has passed since the last one
+        // rates are since the last line, eta is from the average rate of the whole run
+        void update(long long games, long long decisions) {
+
+            steady_clock::time_point now = steady_clock::now();
+            double sinceReport = this->secondsSince(this->lastReport, now);
+            if (sinceReport < this->intervalSeconds) {
+                return;
+            }
+
+            double elapsed = this->secondsSince(this->start, now);
+            double gameRate = (games - this->lastGames) / sinceReport;
+            double decisionRate = (decisions - this->lastDecisions) / sinceReport;
+            double averageRate = games / elapsed;
+            double eta = (averageRate > 0) ? (this->totalGames - games) / averageRate : 0;
+
+            // share of time in each phase so far, counting the open phase
+            double phaseTotal = 0;
+            double shares[TRAINING_PHASE_COUNT];
+            for (int p = 0; p < TRAINING_PHASE_COUNT; p ++) {
+
+                shares[p] = this->phaseSeconds[p] + ((p == this->phase) ? this->secondsSince(this->phaseStart, now) : 0);
+                phaseTotal += shares[p];
+
+            }
+
+            stringstream line;
+            line << fixed << setprecision(1);
+            line << "Games " << games << "/" << this->totalGames << " (" << 100.0 * games / this->totalGames << "%)";
+            line << "  " << shortRate(gameRate) << " games/s";
+            line << "  " << shortRate(decisionRate) << " decisions/s";
+            for (int p = 0; p < TRAINING_PHASE_COUNT; p ++) {
+                line << "  " << TRAINING_PHASE_NAMES[p] << " " << ((phaseTotal > 0) ? 100 * shares[p] / phaseTotal : 0) << "%";
+            }
+            line << "  elapsed " << clockTime(elapsed) << "  eta " << clockTime(eta);
+            this->logger->log(line.str());
+
+            this->lastReport = now;
+            this->lastGames = games;
+            this->lastDecisions = decisions;
+
+        }
+
+        // closes the open phase and keeps the run's totals for the summary
+        void finish(long long games, long long decisions) {
+
+            this->startPhase(this->phase);
+            this->finalGames = games;
+            this->finalDecisions = decisions;
+            this->totalSeconds = this->secondsSince(this->start, steady_clock::now());
+
+        }
+
+        // writes the run's throughput and phase times
+        void writeSummary(ostream& outfile) const {
+
+            outfile << "Throughput:" << endl;
+            outfile << "\ttotal time: " << this->totalSeconds << " s" << endl;
+            for (int p = 0; p < TRAINING_PHASE_COUNT; p ++) {
+
+                double share = (this->totalSeconds > 0) ? 100 * this->phaseSeconds[p] / this->totalSeconds : 0;
+                outfile << "\t" << TRAINING_PHASE_NAMES[p] << " time: " << this->phaseSeconds[p] << " s (" << share << "%)" << endl;
+
+            }
+            outfile << "\tgames/sec: " << ((this->totalSeconds > 0) ? this->finalGames / this->totalSeconds : 0) << endl;
+            outfile << "\tdecisions/sec: " << ((this->totalSeconds > 0) ? this->finalDecisions / this->totalSeconds : 0) << endl;
+
+        }
+
+};
+
+#endif
@@ -0,0 +1,344 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: append only binary log of q table and training count snapshots taken while
+             training, and the memory mapped reader that plays them back
+*/
+
+// file guards
+#ifndef Q_LOG_H
+#define Q_LOG_H
+
+// imports
+#include <string>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "BlackJackAgent.h"
+#include "Trace.h"
+
+// namespace
+using std::string;
+using std::ofstream;
+using std::ios;
+using std::vector;
+using std::llround;
+using std::memcpy, std::memset;
+using std::function;
+
+// file layout, all numbers little endian as this machine writes them
+//   header   QLogHeader
+//   frames   QLogFrameHeader then payloadBytes of cells, appended one per snapshot
+// each cell (rows, then columns, then actions) is two zigzag varints, the change in its
+// fixed point q value and the change in its training count since the last frame
+// the first frame's changes are from zero, and a frame cut short by a crash is ignored
+const uint32_t Q_LOG_MAGIC = 0x474f4c51; // "QLOG"
+const uint32_t Q_LOG_FRAME_MAGIC = 0x4d415246; // "FRAM"
+const uint32_t Q_LOG_VERSION = 1;
+
+// q values are kept to this step, fine enough that chart choices don't change
+const double Q_LOG_RESOLUTION = 1e-6;
+
+// q table cells in a snapshot
+const int Q_LOG_CELLS = PLAYER_HAND_COUNT * DEALER_HAND_COUNT * ACTION_TYPE_COUNT;
+
+// longest a varint of 64 bits can be
+const int MAX_VARINT_BYTES = 10;
+
+// start of the file
+struct QLogHeader {
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t rows;
+    uint32_t columns;
+    uint32_t actions;
+    uint32_t reserved;
+    double resolution;
+
+};
+
+// start of each frame
+struct QLogFrameHeader {
+
+    uint32_t magic;
+    uint32_t payloadBytes;
+    uint64_t games;
+    uint64_t trainingCount;
+
+};
+
+// a decoded snapshot
+struct QLogSnapshot {
+
+    long long games;
+    long long trainingCount;
+    double qTable[PLAYER_HAND_COUNT][DEALER_HAND_COUNT][ACTION_TYPE_COUNT];
+    long long counts[PLAYER_HAND_COUNT][DEALER_HAND_COUNT][ACTION_TYPE_COUNT];
+
+};
+
+// adds a signed number to a buffer as a zigzag varint, small changes of either sign take a byte
+void putVarint(unsigned char*& out, long long value) {
+
+    uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    while (zigzag >= 0x80) {
+
+        *out++ = static_cast<unsigned char>(zigzag | 0x80);
+        zigzag >>= 7;
+
+    }
+    *out++ = static_cast<unsigned char>(zigzag);
+
+}
+
+// reads a zigzag varint, false if it runs past the end
+bool getVarint(const unsigned char*& in, const unsigned char* end, long long& value) {
+
+    uint64_t zigzag = 0;
+    for (int shift = 0; in < end && shift < 7 * MAX_VARINT_BYTES; shift += 7) {
+
+        unsigned char byte = *in++;
+        zigzag |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+
+            value = static_cast<long long>(zigzag >> 1) ^ -static_cast<long long>(zigzag & 1);
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+// writes snapshots of an agent's q table and training counts as training goes
+// a frame is encoded into a buffer sized for the worst case, so logging never allocates
+class QLogWriter {
+
+    private:
+
+        ofstream outfile;
+
+        // fixed point q values and counts of the last frame
+        long long lastQ[Q_LOG_CELLS];
+        long long lastCounts[Q_LOG_CELLS];
+
+        // frame being encoded
+        unsigned char frame[sizeof(QLogFrameHeader) + 2 * MAX_VARINT_BYTES * Q_LOG_CELLS];
+
+    public:
+
+        // starts a new log, truncating any old one at the path
+        QLogWriter(const string& path) : outfile(path, ios::binary | ios::trunc) {
+
+            memset(this->lastQ, 0, sizeof(this->lastQ));
+            memset(this->lastCounts, 0, sizeof(this->lastCounts));
+
+            QLogHeader header = {Q_LOG_MAGIC, Q_LOG_VERSION, PLAYER_HAND_COUNT, DEALER_HAND_COUNT, ACTION_TYPE_COUNT, 0, Q_LOG_RESOLUTION};
+            this->outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        }
+
+        bool isOpen() const {
+
+            return this->outfile.good();
+
+        }
+
+        // appends a frame with how much each cell changed since the last one
+        void writeSnapshot(long long games, long long trainingCount, double (*qTable)[DEALER_HAND_COUNT][ACTION_TYPE_COUNT], int (*counts)[DEALER_HAND_COUNT][ACTION_TYPE_COUNT]) {
+
+            BJ_TRACE_ZONE("q log snapshot");
+
+            unsigned char* out = this->frame + sizeof(QLogFrameHeader);
+            int cell = 0;
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+                    for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+
+                        long long q = llround(qTable[i][j][k] / Q_LOG_RESOLUTION);
+                        putVarint(out, q - this->lastQ[cell]);
+                        putVarint(out, counts[i][j][k] - this->lastCounts[cell]);
+                        this->lastQ[cell] = q;
+                        this->lastCounts[cell] = counts[i][j][k];
+                        cell ++;
+
+                    }
+                }
+            }
+
+            // header goes in front of the payload so the frame is one write
+            const uint32_t PAYLOAD_BYTES = out - this->frame - sizeof(QLogFrameHeader);
+            QLogFrameHeader header = {Q_LOG_FRAME_MAGIC, PAYLOAD_BYTES, static_cast<uint64_t>(games), static_cast<uint64_t>(trainingCount)};
+            memcpy(this->frame, &header, sizeof(header));
+            this->outfile.write(reinterpret_cast<const char*>(this->frame), out - this->frame);
+            this->outfile.flush();
+
+        }
+
+};
+
+// reads a q log through a memory map and decodes its snapshots in order
+class QLogReader {
+
+    private:
+
+        // mapped file
+        const unsigned char* data;
+        size_t size;
+
+        // where each whole frame starts
+        vector<size_t> frameOffsets;
+
+        // fixed point step the log was written with
+        double resolution;
+
+    public:
+
+        QLogReader() {
+
+            this->data = nullptr;
+            this->size = 0;
+            this->resolution = Q_LOG_RESOLUTION;
+
+        }
+
+        ~QLogReader() {
+
+            if (this->data) {
+                munmap(const_cast<unsigned char*>(this->data), this->size);
+            }
+
+        }
+
+        // maps a log and finds its frames
+        // returns false and says why if it can't be read or was written for another table shape
+        bool open(const string& path, string& error) {
+
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+
+                error = "can't open " + path;
+                return false;
+
+            }
+
+            struct stat info;
+            if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(QLogHeader))) {
+
+                close(fd);
+                error = path + " is too short to be a q log";
+                return false;
+
+            }
+            this->size = info.st_size;
+
+            void* mapped = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (mapped == MAP_FAILED) {
+
+                error = "can't map " + path;
+                return false;
+
+            }
+            this->data = static_cast<const unsigned char*>(mapped);
+
+            // the table has to be the one this build has
+            QLogHeader header;
+            memcpy(&header, this->data, sizeof(header));
+            if (header.magic != Q_LOG_MAGIC || header.version != Q_LOG_VERSION) {
+
+                error = path + " isn't a version " + std::to_string(Q_LOG_VERSION) + " q log";
+                return false;
+
+            }
+            if (header.rows != PLAYER_HAND_COUNT || header.columns != DEALER_HAND_COUNT || header.actions != ACTION_TYPE_COUNT) {
+
+                error = path + " was written for a different q table shape";
+                return false;
+
+            }
+            this->resolution = header.resolution;
+
+            // whole frames, a cut off one at the end is left out
+            size_t offset = sizeof(QLogHeader);
+            while (offset + sizeof(QLogFrameHeader) <= this->size) {
+
+                QLogFrameHeader frame;
+                memcpy(&frame, this->data + offset, sizeof(frame));
+                if (frame.magic != Q_LOG_FRAME_MAGIC || offset + sizeof(frame) + frame.payloadBytes > this->size) {
+                    break;
+                }
+
+                this->frameOffsets.push_back(offset);
+                offset += sizeof(frame) + frame.payloadBytes;
+
+            }
+
+            return true;
+
+        }
+
+        int getSnapshotCount() const {
+
+            return this->frameOffsets.size();
+
+        }
+
+        size_t getSize() const {
+
+            return this->size;
+
+        }
+
+        // decodes every snapshot in order, each one is built on the one before
+        // returns false if a frame's payload doesn't decode
+        bool forEachSnapshot(const function<void(const QLogSnapshot&)>& visit) const {
+
+            QLogSnapshot snapshot;
+            long long q[Q_LOG_CELLS] = {0};
+            long long* counts = &snapshot.counts[0][0][0];
+            memset(snapshot.counts, 0, sizeof(snapshot.counts));
+
+            for (size_t offset : this->frameOffsets) {
+
+                QLogFrameHeader frame;
+                memcpy(&frame, this->data + offset, sizeof(frame));
+                snapshot.games = frame.games;
+                snapshot.trainingCount = frame.trainingCount;
+
+                const unsigned char* in = this->data + offset + sizeof(frame);
+                const unsigned char* end = in + frame.payloadBytes;
+                double* qValues = &snapshot.qTable[0][0][0];
+                for (int cell = 0; cell < Q_LOG_CELLS; cell ++) {
+
+                    long long qChange, countChange;
+                    if (!getVarint(in, end, qChange) || !getVarint(in, end, countChange)) {
+                        return false;
+                    }
+                    q[cell] += qChange;
+                    counts[cell] += countChange;
+                    qValues[cell] = q[cell] * this->resolution;
+
+                }
+
+                visit(snapshot);
+
+            }
+
+            return true;
+
+        }
+
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: bounded replay memory of compact training episodes
+*/
+
+// file guards
+#ifndef REPLAY_BUFFER_H
+#define REPLAY_BUFFER_H
+
+// imports
+#include <vector>
+#include <random>
+#include <cmath>
+
+// namespace
+using std::vector;
+using std::mt19937;
+using std::uniform_real_distribution;
+using std::pow;
+
+// longest episode kept for replay, longer ones are only trained on once
+const int MAX_REPLAY_STEPS = 16;
+
+// smallest priority so every episode can still be drawn
+const double MIN_REPLAY_PRIORITY = 1e-3;
+
+// one action of an episode as q table coordinates
+struct EpisodeStep {
+
+    unsigned char row;
+    unsigned char col;
+    unsigned char action;
+
+};
+
+// a whole game in q table coordinates
+struct CompactEpisode {
+
+    // final game reward
+    float reward;
+
+    // number of steps used
+    unsigned char length;
+
+    // actions in the order taken
+    EpisodeStep steps[MAX_REPLAY_STEPS];
+
+};
+
+// ring buffer of episodes, sampled uniformly or by priority
+class ReplayBuffer {
+
+    private:
+
+        // stored episodes
+        vector<CompactEpisode> episodes;
+
+        // slot for the next episode and number of slots filled
+        int nextSlot;
+        int filled;
+
+        // priority exponent, 0 samples uniformly
+        double priorityExponent;
+
+        // sum tree of sampling weights, leaves start at leafStart
+        vector<double> tree;
+        int leafStart;
+
+        // randomizer for draws
+        mt19937 randomizer;
+
+        // set the sampling weight of a slot and update its parents
+        void setWeight(int slot, double weight) {
+
+            int node = this->leafStart + slot;
+            double change = weight - this->tree.at(node);
+
+            while (node > 0) {
+
+                this->tree.at(node) += change;
+                node /= 2;
+
+            }
+
+        }
+
+    public:
+
+        // constructor
+        ReplayBuffer(int capacity, double priorityExponent, unsigned int seed) {
+
+            this->episodes = vector<CompactEpisode>(capacity);
+            this->nextSlot = 0;
+            this->filled = 0;
+            this->priorityExponent = priorityExponent;
+            this->randomizer = mt19937(seed);
+
+            // leaves padded to a power of two
+            this->leafStart = 1;
+            while (this->leafStart < capacity) {
+                this->leafStart *= 2;
+            }
+            this->tree = vector<double>(2 * this->leafStart, 0);
+
+        }
+
+        // add an episode, overwriting the oldest when full
+        // priority is the size of its last update error
+        void add(const CompactEpisode& episode, double priority) {
+
+            this->episodes.at(this->nextSlot) = episode;
+            this->setPriority(this->nextSlot, priority);
+
+            // move ring forward
+            this->nextSlot = (this->nextSlot + 1) % static_cast<int>(this->episodes.size());
+            if (this->filled < static_cast<int>(this->episodes.size())) {
+                this->filled ++;
+            }
+
+        }
+
+        // update the priority of a slot after replaying it
+        void setPriority(int slot, double priority) {
+
+            double weight = (this->priorityExponent == 0) ? 1 : pow(priority + MIN_REPLAY_PRIORITY, this->priorityExponent);
+            this->setWeight(slot, weight);
+
+        }
+
+        // draw a slot in proportion to its weight
+        int sample() {
+
+            // walk down the tree
+            double target = uniform_real_distribution<double>(0, this->tree.at(1))(this->randomizer);
+            int node = 1;
+            while (node < this->leafStart) {
+
+                if (target < this->tree.at(2 * node) || this->tree.at(2 * node + 1) == 0) {
+
+                    node = 2 * node;
+
+                }
+                else {
+
+                    target -= this->tree.at(2 * node);
+                    node = 2 * node + 1;
+
+                }
+
+            }
+
+            return node - this->leafStart;
+
+        }
+
+        // episode in a slot
+        const CompactEpisode& getEpisode(int slot) const {
+            return this->episodes.at(slot);
+        }
+
+        // number of episodes stored
+        int size() const {
+            return this->filled;
+        }
+
+};
+
+#endif
@@ -0,0 +1,611 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: append only store of every training run and evaluation, indexed by chart
+             and field, with the importer for the parameters and eval files
+*/
+
+// file guards
+#ifndef RESULTS_STORE_H
+#define RESULTS_STORE_H
+
+// imports
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include "ChartIO.h"
+
+// namespace
+using std::string;
+using std::ofstream, std::ifstream;
+using std::stringstream;
+using std::getline;
+using std::vector;
+using std::map;
+using std::sort, std::replace;
+using std::strtod;
+namespace fs = std::filesystem;
+
+// store next to the charts, one record per line
+// lines are only ever added, a newer record of the same file replaces an older one in queries
+const string RESULTS_STORE_PATH = "../charts/results.store";
+
+// free text notes imported along with the charts
+const string CHART_NOTES_PATH = "../Chart_notes.txt";
+
+// record kinds
+const string TRAIN_RECORD = "train";
+const string EVAL_RECORD = "eval";
+const string NOTE_RECORD = "note";
+
+// a labelled line of a parameters or eval file that becomes a record field
+// section is the unindented "Name:" line the label sits under, empty at the top level
+struct FieldLabel {
+
+    string section;
+    string label;
+    string field;
+    bool number;
+
+};
+
+// parameters file lines, from driver or the solver
+const vector<FieldLabel> PARAMETER_LABELS = {
+
+    {"", "Chart note", "note", false},
+    {"", "Method", "method", false},
+    {"Epsilon Function", "type", "epsilon_type", false},
+    {"Epsilon Function", "x coefficient", "epsilon_coefficient", true},
+    {"Epsilon Function", "x right shift", "epsilon_shift", true},
+    {"", "Gamma", "gamma", true},
+    {"", "Alpha", "alpha", true},
+    {"Alpha schedule", "type", "alpha_schedule", false},
+    {"Alpha schedule", "power", "alpha_power", true},
+    {"Update target", "type", "update_target", false},
+    {"Update target", "lambda", "lambda", true},
+    {"Replay", "buffer size", "replay_size", true},
+    {"Replay", "replay ratio", "replay_ratio", true},
+    {"Replay", "minibatch size", "replay_batch", true},
+    {"Replay", "priority exponent", "replay_priority", true},
+    {"", "Game count", "games", true},
+    {"", "Training interval", "train_every", true},
+    {"Exploring starts", "mode", "start_mode", false},
+    {"Exploring starts", "rate", "start_rate", true},
+    {"", "Deck count", "decks", false},
+    {"", "Reshuffle interval", "reshuffle_decks", true},
+    {"", "Solve time", "solve_ms", true},
+    {"Rewards", "Win", "reward_win", true},
+    {"Rewards", "Blackjack", "reward_blackjack", true},
+    {"Rewards", "Double", "reward_double", true},
+    {"Rewards", "Loss", "reward_loss", true},
+    {"Rewards", "Double loss", "reward_double_loss", true},
+    {"Rewards", "Push", "reward_push", true},
+    {"Throughput", "total time", "train_seconds", true},
+    {"Throughput", "games/sec", "games_per_sec", true},
+    {"Throughput", "decisions/sec", "decisions_per_sec", true}
+
+};
+
+// eval file lines, edges and risk of ruin are in percent
+const vector<FieldLabel> EVAL_LABELS = {
+
+    {"", "Gambling rounds", "rounds", true},
+    {"", "Games per round", "games_per_round", true},
+    {"", "Round starting balance", "starting_balance", true},
+    {"", "Bet per game", "bet", false},
+    {"", "Deck count", "decks", true},
+    {"", "Decks dealt before reshuffle", "reshuffle_decks", true},
+    {"", "Seed", "seed", true},
+    {"", "Stopping rule", "stopping_rule", false},
+    {"Results", "Average final balance", "average_balance", true},
+    {"Results", "Average balance increase", "balance_increase", true},
+    {"Results", "Hands played", "hands", true},
+    {"Results", "Edge per hand", "edge", true},
+    {"Results", "Standard error", "edge_se", true},
+    {"Results", "Risk of ruin", "ruin", true},
+    {"Results", "Average max drawdown", "max_drawdown", true}
+
+};
+
+// one training run, eval or note
+struct ResultRecord {
+
+    string kind;
+    map<string, string> fields;
+
+};
+
+// field of a record, empty if it doesn't have one
+string recordField(const ResultRecord& record, const string& field) {
+
+    map<string, string>::const_iterator found = record.fields.find(field);
+    return (found == record.fields.end()) ? "" : found->second;
+
+}
+
+// text without the spaces and tabs around it
+string trimmed(const string& text) {
+
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == string::npos) {
+        return "";
+    }
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+
+}
+
+// the number a value starts with, after any $, so "$-0.27 | -0.02%" gives "-0.27"
+// empty if it doesn't start with one
+string leadingNumber(const string& value) {
+
+    size_t start = value.find_first_not_of(" $");
+    if (start == string::npos) {
+        return "";
+    }
+
+    const char* begin = value.c_str() + start;
+    char* end;
+    strtod(begin, &end);
+    return value.substr(start, end - begin);
+
+}
+
+// true and the number if all of a value is one
+bool parseNumber(const string& value, double& number) {
+
+    if (value.empty()) {
+        return false;
+    }
+
+    char* end;
+    number = strtod(value.c_str(), &end);
+    return *end == '\0';
+
+}
+
+// key a value is indexed under, numbers by value so 0.004 finds 0.004000
+string indexKey(const string& value) {
+
+    double number;
+    if (!parseNumber(value, number)) {
+        return value;
+    }
+
+    char key[32];
+    snprintf(key, sizeof(key), "%.15g", number);
+    return key;
+
+}
+
+// the local time, for when a record was added
+string recordTime() {
+
+    char text[32];
+    time_t now = time(0);
+    strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    return text;
+
+}
+
+// record as a store line, the kind then tab separated field=value pairs
+// tabs and line breaks in values become spaces so a record is always one line
+string recordLine(const ResultRecord& record) {
+
+    string line = record.kind;
+    for (const auto& [field, value] : record.fields) {
+
+        string clean = value;
+        replace(clean.begin(), clean.end(), '\t', ' ');
+        replace(clean.begin(), clean.end(), '\n', ' ');
+        replace(clean.begin(), clean.end(), '\r', ' ');
+        line += "\t" + field + "=" + clean;
+
+    }
+
+    return line;
+
+}
+
+// store line back into a record, false for a blank line
+bool parseRecordLine(const string& line, ResultRecord& record) {
+
+    stringstream lineStream(line);
+    string part;
+    if (!getline(lineStream, record.kind, '\t') || trimmed(record.kind).empty()) {
+        return false;
+    }
+
+    record.fields.clear();
+    while (getline(lineStream, part, '\t')) {
+
+        size_t equals = part.find('=');
+        if (equals != string::npos) {
+            record.fields[part.substr(0, equals)] = part.substr(equals + 1);
+        }
+
+    }
+
+    return true;
+
+}
+
+// reads the labelled lines of a parameters or eval file into fields
+// the first line has to contain heading so other text files aren't taken for one
+// returns false if the file can't be opened or isn't the right kind
+bool readLabelledFile(const string& path, const string& heading, const vector<FieldLabel>& labels, map<string, string>& fields) {
+
+    ifstream infile(path);
+    string line;
+    if (!getline(infile, line) || line.find(heading) == string::npos) {
+        return false;
+    }
+
+    string section;
+    while (getline(infile, line)) {
+
+        bool indented = !line.empty() && (line.at(0) == '\t' || line.at(0) == ' ');
+        size_t colon = line.find(':');
+        if (colon == string::npos) {
+
+            if (!indented) {
+                section = "";
+            }
+            continue;
+
+        }
+
+        string label = trimmed(line.substr(0, colon));
+        string value = trimmed(line.substr(colon + 1));
+
+        // unindented line with nothing after its colon starts a section
+        if (!indented) {
+
+            section = value.empty() ? label : "";
+            if (value.empty()) {
+                continue;
+            }
+
+        }
+
+        for (const FieldLabel& known : labels) {
+
+            if (known.section == section && known.label == label) {
+
+                string fieldValue = known.number ? leadingNumber(value) : value;
+                if (!fieldValue.empty()) {
+                    fields[known.field] = fieldValue;
+                }
+
+            }
+
+        }
+
+    }
+
+    return true;
+
+}
+
+// training run record from its parameters file
+// source is where the file lives under the charts folder
+bool readTrainingRecord(const string& path, const string& chartId, const string& source, ResultRecord& record) {
+
+    record.kind = TRAIN_RECORD;
+    record.fields.clear();
+    if (!readLabelledFile(path, "parameters for chart", PARAMETER_LABELS, record.fields)) {
+        return false;
+    }
+
+    record.fields["chart"] = chartId;
+    record.fields["source"] = source;
+    record.fields["recorded"] = recordTime();
+
+    return true;
+
+}
+
+// eval record from its eval file, the eval id is empty for a chart's main eval
+bool readEvalRecord(const string& path, const string& chartId, const string& evalId, const string& source, ResultRecord& record) {
+
+    record.kind = EVAL_RECORD;
+    record.fields.clear();
+    if (!readLabelledFile(path, "Evaluation for Chart", EVAL_LABELS, record.fields)) {
+        return false;
+    }
+
+    record.fields["chart"] = chartId;
+    if (!evalId.empty()) {
+        record.fields["eval_id"] = evalId;
+    }
+    record.fields["source"] = source;
+    record.fields["recorded"] = recordTime();
+
+    return true;
+
+}
+
+// every record of the store file, indexed by chart and by field value
+class ResultsStore {
+
+    private:
+
+        // store file
+        string path;
+
+        // records in the order they were added
+        vector<ResultRecord> records;
+
+        // record numbers by chart id, and by field then value key
+        map<string, vector<int>> chartIndex;
+        map<string, map<string, vector<int>>> fieldIndex;
+
+        // newest record of each training or eval file, and the record that replaced each record, -1 if none
+        // notes all come from one file and are never replaced
+        map<string, int> latestBySource;
+        vector<int> replacedBy;
+
+        // adds the last record to the indexes
+        void indexLast() {
+
+            const int r = this->records.size() - 1;
+            const ResultRecord& record = this->records.at(r);
+            string chartId = recordField(record, "chart");
+            if (!chartId.empty()) {
+                this->chartIndex[chartId].push_back(r);
+            }
+
+            this->replacedBy.push_back(-1);
+            string source = recordField(record, "source");
+            if (record.kind != NOTE_RECORD && !source.empty()) {
+
+                map<string, int>::iterator older = this->latestBySource.find(record.kind + ":" + source);
+                if (older != this->latestBySource.end()) {
+
+                    this->replacedBy.at(older->second) = r;
+                    older->second = r;
+
+                }
+                else {
+
+                    this->latestBySource[record.kind + ":" + source] = r;
+
+                }
+
+            }
+            for (const auto& [field, value] : record.fields) {
+                this->fieldIndex[field][indexKey(value)].push_back(r);
+            }
+
+        }
+
+    public:
+
+        ResultsStore(const string& path) {
+
+            this->path = path;
+
+        }
+
+        // reads the whole store, a missing store is an empty one
+        void load() {
+
+            this->records.clear();
+            this->chartIndex.clear();
+            this->fieldIndex.clear();
+            this->latestBySource.clear();
+            this->replacedBy.clear();
+
+            ifstream infile(this->path);
+            string line;
+            ResultRecord record;
+            while (getline(infile, line)) {
+
+                if (parseRecordLine(line, record)) {
+
+                    this->records.push_back(record);
+                    this->indexLast();
+
+                }
+
+            }
+
+        }
+
+        // adds a record to the end of the store file and to the loaded records
+        // the line is written in one go so a crash can't leave half a record
+        bool append(const ResultRecord& record) {
+
+            ofstream outfile(this->path, std::ios::app);
+            outfile << recordLine(record) + "\n";
+            outfile.flush();
+            if (!outfile.good()) {
+                return false;
+            }
+
+            this->records.push_back(record);
+            this->indexLast();
+            return true;
+
+        }
+
+        const string& getPath() const {
+
+            return this->path;
+
+        }
+
+        const vector<ResultRecord>& getRecords() const {
+
+            return this->records;
+
+        }
+
+        const ResultRecord& getRecord(int r) const {
+
+            return this->records.at(r);
+
+        }
+
+        // record numbers of a chart, oldest first
+        const vector<int>& findChart(const string& chartId) const {
+
+            static const vector<int> NONE;
+            map<string, vector<int>>::const_iterator found = this->chartIndex.find(chartId);
+            return (found == this->chartIndex.end()) ? NONE : found->second;
+
+        }
+
+        // record numbers with a field equal to a value, numbers compared by value
+        const vector<int>& findField(const string& field, const string& value) const {
+
+            static const vector<int> NONE;
+            map<string, map<string, vector<int>>>::const_iterator byField = this->fieldIndex.find(field);
+            if (byField == this->fieldIndex.end()) {
+                return NONE;
+            }
+            map<string, vector<int>>::const_iterator found = byField->second.find(indexKey(value));
+            return (found == byField->second.end()) ? NONE : found->second;
+
+        }
+
+        // false once a newer record of the same file has been added
+        bool isCurrent(int r) const {
+
+            return this->replacedBy.at(r) == -1;
+
+        }
+
+        // newest record of a kind for a chart, -1 if there isn't one
+        int findLatest(const string& chartId, const string& kind) const {
+
+            const vector<int>& chartRecords = this->findChart(chartId);
+            for (int i = chartRecords.size() - 1; i >= 0; i --) {
+
+                if (this->records.at(chartRecords.at(i)).kind == kind) {
+                    return chartRecords.at(i);
+                }
+
+            }
+
+            return -1;
+
+        }
+
+};
+
+// adds a record of a file driver or eval just wrote to the store
+// the store isn't read, the line is only appended
+bool appendRunRecord(const ResultRecord& record) {
+
+    ofstream outfile(RESULTS_STORE_PATH, std::ios::app);
+    outfile << recordLine(record) + "\n";
+    outfile.flush();
+    return outfile.good();
+
+}
+
+// adds a training run from the parameters file driver wrote in src
+// run.sh moves the file into the chart's folder, which is the source recorded
+bool recordTrainingRun(const string& paramPath, const string& chartId) {
+
+    ResultRecord record;
+    string source = "Chart" + chartId + "/" + fs::path(paramPath).filename().string();
+    return readTrainingRecord(paramPath, chartId, source, record) && appendRunRecord(record);
+
+}
+
+// adds an eval from the eval file in its chart's folder
+bool recordEval(const string& evalPath, const string& chartId, const string& evalId) {
+
+    ResultRecord record;
+    string source = "Chart" + chartId + "/" + fs::path(evalPath).filename().string();
+    return readEvalRecord(evalPath, chartId, evalId, source, record) && appendRunRecord(record);
+
+}
+
+// adds every chart's parameters and eval files the store doesn't have a record of yet,
+// and each line of the notes file it doesn't have yet
+// returns the number of records added
+int importChartFiles(ResultsStore& store, const string& chartsDir, const string& notesPath) {
+
+    int added = 0;
+    ResultRecord record;
+    for (const string& chartId : findChartIds(chartsDir)) {
+
+        const string CHART_DIR = "Chart" + chartId;
+
+        // training parameters
+        const string PARAM_SOURCE = CHART_DIR + "/" + chartId + "_parameters.txt";
+        if (store.findField("source", PARAM_SOURCE).empty() && readTrainingRecord(chartsDir + "/" + PARAM_SOURCE, chartId, PARAM_SOURCE, record)) {
+
+            store.append(record);
+            added ++;
+
+        }
+
+        // evals, Eval<id>.txt and Eval<id>_<eval id>.txt
+        const string EVAL_PREFIX = "Eval" + chartId;
+        vector<string> evalFiles;
+        for (const fs::directory_entry& entry : fs::directory_iterator(chartsDir + "/" + CHART_DIR)) {
+
+            string name = entry.path().filename().string();
+            if (name.compare(0, EVAL_PREFIX.size(), EVAL_PREFIX) == 0 && entry.path().extension() == ".txt") {
+                evalFiles.push_back(name);
+            }
+
+        }
+        sort(evalFiles.begin(), evalFiles.end());
+
+        for (const string& name : evalFiles) {
+
+            string stem = name.substr(EVAL_PREFIX.size(), name.size() - EVAL_PREFIX.size() - 4);
+            if (!stem.empty() && stem.at(0) != '_') {
+                continue;
+            }
+            string evalId = stem.empty() ? "" : stem.substr(1);
+
+            const string EVAL_SOURCE = CHART_DIR + "/" + name;
+            if (store.findField("source", EVAL_SOURCE).empty() && readEvalRecord(chartsDir + "/" + EVAL_SOURCE, chartId, evalId, EVAL_SOURCE, record)) {
+
+                store.append(record);
+                added ++;
+
+            }
+
+        }
+
+    }
+
+    // notes, one record per line
+    ifstream notesfile(notesPath);
+    string line;
+    while (getline(notesfile, line)) {
+
+        string text = trimmed(line);
+        if (text.empty() || !store.findField("text", text).empty()) {
+            continue;
+        }
+
+        record.kind = NOTE_RECORD;
+        record.fields.clear();
+        record.fields["text"] = text;
+        record.fields["source"] = fs::path(notesPath).filename().string();
+        record.fields["recorded"] = recordTime();
+        store.append(record);
+        added ++;
+
+    }
+
+    return added;
+
+}
+
+#endif
@@ -0,0 +1,597 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: exact action values for every chart cell by recursion over the game rules
+*/
+
+// file guards
+#ifndef SOLVER_H
+#define SOLVER_H
+
+// imports
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+
+// namespace
+using std::vector;
+using std::unordered_map;
+using std::fabs;
+using std::max;
+
+// number of card values (ace through ten)
+const int CARD_VALUE_COUNT = 10;
+
+// dealer final totals tracked by the solver
+// index 0-4 is 17-21, index 5 is bust
+const int DEALER_OUTCOME_COUNT = 6;
+const int DEALER_BUST_INDEX = 5;
+
+// split fixed point stops when the value moves less than this
+const double SPLIT_TOLERANCE = 1e-12;
+
+// solves the same game as Game with the same Scoring
+//
+// rules follow Game and the chart players in driver/eval:
+//  - dealer stands on all 17s and peeks, a dealer blackjack ends the hand as a loss
+//  - any two starting cards summing to 11 are paid as a blackjack (Game's check)
+//  - hard 21 must stand, double on any first two cards including after a split
+//  - any pair can split and resplit, split hands are never blackjacks
+//  - a bust after doubling pays the plain loss, as Game::hit scores it
+//
+// deck count 0 is an infinite deck, otherwise values are composition dependent
+// for a fresh shoe of that many decks, averaged over the hands that land on each cell
+// finite deck splits ignore the cards drawn to the other split hand
+class StrategySolver {
+
+    private:
+
+        // rewards
+        Scoring scores;
+
+        // number of decks, 0 for infinite
+        int deckCount;
+
+        // cards in a fresh shoe by value index (value - 1)
+        int shoe[CARD_VALUE_COUNT];
+
+        // solved action values
+        // table[player hand][dealer hand][action], split is total value of both hands
+        double qTable[PLAYER_HAND_COUNT][DEALER_HAND_COUNT][ACTION_TYPE_COUNT];
+
+        // current dealer upcard
+        int upcard;
+
+        // cards left before the player's hand is removed
+        int base[CARD_VALUE_COUNT];
+        int baseTotal;
+
+        // player hand by value index
+        int hand[CARD_VALUE_COUNT];
+        int handTotal;
+
+        // memos for the current upcard and base, keyed by hand
+        unordered_map<uint64_t, double> continueMemo;
+        unordered_map<uint64_t, vector<double>> dealerMemo;
+
+        // memo key for the current hand
+        // infinite deck values only depend on the sum and ace, finite on the whole hand
+        uint64_t handKey(int hardSum, bool hasAce) const {
+
+            if (this->deckCount == 0) {
+                return hardSum * 2 + (hasAce ? 1 : 0);
+            }
+
+            // five bits per card value, no value can show up 32 times under 22
+            uint64_t key = 0;
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                key |= static_cast<uint64_t>(this->hand[v]) << (5 * v);
+
+            }
+            return key;
+
+        }
+
+        // chance of the next card being a value (index) with the hand removed
+        double cardProb(int v) const {
+
+            if (this->deckCount == 0) {
+                return (v == CARD_VALUE_COUNT - 1) ? 4.0 / 13.0 : 1.0 / 13.0;
+            }
+
+            return static_cast<double>(this->base[v] - this->hand[v]) / (this->baseTotal - this->handTotal);
+
+        }
+
+        // add or remove a card (value index) from the player hand
+        void pushCard(int v) {
+            this->hand[v] ++;
+            this->handTotal ++;
+        }
+        void popCard(int v) {
+            this->hand[v] --;
+            this->handTotal --;
+        }
+
+        // dealer draws out a hand from a remaining deck
+        // adds the chance of each final total into outcomes
+        void dealerDraw(int remaining[CARD_VALUE_COUNT], int remainingTotal, int dealerSum, bool dealerHasAce, double chance, vector<double>& outcomes) const {
+
+            // same stand check as Game::playDealer
+            bool dealerWillStand = (dealerSum >= DEALER_STAND || ((dealerSum + 10) >= DEALER_STAND && (dealerSum + 10) <= 21 && dealerHasAce));
+
+            // busted
+            if (dealerSum > 21) {
+
+                outcomes.at(DEALER_BUST_INDEX) += chance;
+                return;
+
+            }
+
+            // standing, use ace as 11 if it doesn't bust
+            if (dealerWillStand) {
+
+                int finalSum = ((dealerSum + 10) <= 21 && dealerHasAce) ? (dealerSum + 10) : dealerSum;
+                outcomes.at(finalSum - DEALER_STAND) += chance;
+                return;
+
+            }
+
+            // draw every card
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                // chance of the card
+                double cardChance;
+                if (this->deckCount == 0) {
+
+                    cardChance = (v == CARD_VALUE_COUNT - 1) ? 4.0 / 13.0 : 1.0 / 13.0;
+
+                }
+                else {
+
+                    if (remaining[v] == 0) {
+                        continue;
+                    }
+                    cardChance = static_cast<double>(remaining[v]) / remainingTotal;
+                    remaining[v] --;
+
+                }
+
+                this->dealerDraw(remaining, remainingTotal - 1, dealerSum + v + 1, dealerHasAce || v == 0, chance * cardChance, outcomes);
+
+                if (this->deckCount != 0) {
+                    remaining[v] ++;
+                }
+
+            }
+
+        }
+
+        // dealer final total chances for the current hand, given no dealer blackjack
+        const vector<double>& dealerOutcomes(int hardSum, bool hasAce) {
+
+            // infinite deck dealer never depends on the player hand
+            uint64_t key = (this->deckCount == 0) ? 0 : this->handKey(hardSum, hasAce);
+
+            // check memo
+            auto found = this->dealerMemo.find(key);
+            if (found != this->dealerMemo.end()) {
+                return found->second;
+            }
+
+            // remaining deck
+            int remaining[CARD_VALUE_COUNT];
+            int remainingTotal = 0;
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                remaining[v] = this->base[v] - this->hand[v];
+                remainingTotal += remaining[v];
+
+            }
+
+            // card that would give the dealer a blackjack
+            int blackjackCard = (this->upcard == 1) ? CARD_VALUE_COUNT - 1 : (this->upcard == 10) ? 0 : -1;
+
+            // chance of not drawing it as the hole card
+            double noBlackjack = 1;
+            if (blackjackCard != -1) {
+
+                noBlackjack = 1 - this->holeChance(remaining, remainingTotal, blackjackCard);
+
+            }
+
+            // draw the hole card, skipping a blackjack
+            vector<double> outcomes(DEALER_OUTCOME_COUNT, 0);
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                if (v == blackjackCard) {
+                    continue;
+                }
+
+                double cardChance = this->holeChance(remaining, remainingTotal, v);
+                if (cardChance == 0) {
+                    continue;
+                }
+
+                if (this->deckCount != 0) {
+                    remaining[v] --;
+                }
+
+                this->dealerDraw(remaining, remainingTotal - 1, this->upcard + v + 1, this->upcard == 1 || v == 0, cardChance / noBlackjack, outcomes);
+
+                if (this->deckCount != 0) {
+                    remaining[v] ++;
+                }
+
+            }
+
+            return this->dealerMemo[key] = outcomes;
+
+        }
+
+        // chance of a card value (index) coming off a remaining deck
+        double holeChance(const int remaining[CARD_VALUE_COUNT], int remainingTotal, int v) const {
+
+            if (this->deckCount == 0) {
+                return (v == CARD_VALUE_COUNT - 1) ? 4.0 / 13.0 : 1.0 / 13.0;
+            }
+
+            return static_cast<double>(remaining[v]) / remainingTotal;
+
+        }
+
+        // value of standing with the current hand
+        double standValue(int hardSum, bool hasAce, double winScore, double lossScore) {
+
+            // player total with ace as 11 if it doesn't bust
+            int playerTotal = ((hardSum + 10) <= 21 && hasAce) ? (hardSum + 10) : hardSum;
+
+            const vector<double>& outcomes = this->dealerOutcomes(hardSum, hasAce);
+
+            // add up wins, losses and pushes
+            double value = outcomes.at(DEALER_BUST_INDEX) * winScore;
+            for (int i = 0; i < DEALER_BUST_INDEX; i ++) {
+
+                int dealerTotal = i + DEALER_STAND;
+
+                if (dealerTotal < playerTotal) {
+                    value += outcomes.at(i) * winScore;
+                }
+                else if (dealerTotal > playerTotal) {
+                    value += outcomes.at(i) * lossScore;
+                }
+                else {
+                    value += outcomes.at(i) * this->scores.push;
+                }
+
+            }
+
+            return value;
+
+        }
+
+        // value of the current hand playing on with stand or hit (no double or split)
+        double continueValue(int hardSum, bool hasAce) {
+
+            // check memo
+            uint64_t key = this->handKey(hardSum, hasAce);
+            auto found = this->continueMemo.find(key);
+            if (found != this->continueMemo.end()) {
+                return found->second;
+            }
+
+            // hard 21 has to stand
+            double value = this->standValue(hardSum, hasAce, this->scores.win, this->scores.loss);
+            if (hardSum != 21) {
+
+                value = max(value, this->hitValue(hardSum, hasAce));
+
+            }
+
+            return this->continueMemo[key] = value;
+
+        }
+
+        // value of hitting the current hand and playing on
+        double hitValue(int hardSum, bool hasAce) {
+
+            double value = 0;
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                double cardChance = this->cardProb(v);
+                if (cardChance == 0) {
+                    continue;
+                }
+
+                // bust
+                if (hardSum + v + 1 > 21) {
+
+                    value += cardChance * this->scores.loss;
+                    continue;
+
+                }
+
+                this->pushCard(v);
+                value += cardChance * this->continueValue(hardSum + v + 1, hasAce || v == 0);
+                this->popCard(v);
+
+            }
+
+            return value;
+
+        }
+
+        // value of doubling the current hand
+        double doubleValue(int hardSum, bool hasAce) {
+
+            double value = 0;
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                double cardChance = this->cardProb(v);
+                if (cardChance == 0) {
+                    continue;
+                }
+
+                // bust pays the plain loss, as Game::hit scores it
+                if (hardSum + v + 1 > 21) {
+
+                    value += cardChance * this->scores.loss;
+                    continue;
+
+                }
+
+                this->pushCard(v);
+                value += cardChance * this->standValue(hardSum + v + 1, hasAce || v == 0, this->scores.doubleWin, this->scores.doubleLoss);
+                this->popCard(v);
+
+            }
+
+            return value;
+
+        }
+
+        // value of one split hand started from a card value (index)
+        // resplits are solved by iterating the value to a fixed point
+        double splitHandValue(int c) {
+
+            // hand holds the split card
+            this->pushCard(c);
+
+            // best value of each second card without resplitting
+            double secondChance[CARD_VALUE_COUNT];
+            double secondValue[CARD_VALUE_COUNT];
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                secondChance[v] = this->cardProb(v);
+                secondValue[v] = 0;
+                if (secondChance[v] == 0) {
+                    continue;
+                }
+
+                int hardSum = c + v + 2;
+                bool hasAce = c == 0 || v == 0;
+
+                this->pushCard(v);
+                secondValue[v] = max(this->continueValue(hardSum, hasAce), this->doubleValue(hardSum, hasAce));
+                this->popCard(v);
+
+            }
+
+            this->popCard(c);
+
+            // iterate split value with resplits on a matching second card
+            double value = 0;
+            double lastValue;
+            do {
+
+                lastValue = value;
+                value = 0;
+                for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                    double cardValue = secondValue[v];
+                    if (v == c) {
+                        cardValue = max(cardValue, 2 * lastValue);
+                    }
+                    value += secondChance[v] * cardValue;
+
+                }
+
+            } while (fabs(value - lastValue) > SPLIT_TOLERANCE);
+
+            return value;
+
+        }
+
+        // set the deck for an upcard with extra cards removed
+        void setBase(int dealerShowing, int extraRemoved) {
+
+            this->upcard = dealerShowing;
+            this->baseTotal = 0;
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                this->base[v] = this->shoe[v];
+                this->hand[v] = 0;
+
+            }
+
+            // remove upcard and any extra card
+            this->base[dealerShowing - 1] --;
+            if (extraRemoved != -1) {
+                this->base[extraRemoved] --;
+            }
+
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+                this->baseTotal += this->base[v];
+            }
+            this->handTotal = 0;
+
+            // memos belong to the old deck
+            this->continueMemo.clear();
+            this->dealerMemo.clear();
+
+        }
+
+        // chance of drawing a hand from the base deck without the dealer having blackjack
+        double handWeight(const vector<int>& cards) {
+
+            // infinite deck weight is the product of card chances
+            if (this->deckCount == 0) {
+
+                double weight = 1;
+                for (unsigned int i = 0; i < cards.size(); i ++) {
+                    weight *= (cards.at(i) == 10) ? 4.0 / 13.0 : 1.0 / 13.0;
+                }
+                return weight;
+
+            }
+
+            // chance of the hand in draw order, times the ways to order it
+            double weight = 1;
+            int counts[CARD_VALUE_COUNT] = {0};
+            for (unsigned int i = 0; i < cards.size(); i ++) {
+
+                int v = cards.at(i) - 1;
+                weight *= static_cast<double>(this->base[v] - counts[v]) / (this->baseTotal - static_cast<int>(i));
+                counts[v] ++;
+
+            }
+
+            // orderings of the multiset
+            double orderings = 1;
+            for (unsigned int i = 2; i <= cards.size(); i ++) {
+                orderings *= i;
+            }
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+                for (int k = 2; k <= counts[v]; k ++) {
+                    orderings /= k;
+                }
+            }
+
+            // dealer peeks, skip hands that never reach a decision
+            int blackjackCard = (this->upcard == 1) ? CARD_VALUE_COUNT - 1 : (this->upcard == 10) ? 0 : -1;
+            double noBlackjack = 1;
+            if (blackjackCard != -1) {
+
+                int remainingTotal = this->baseTotal - static_cast<int>(cards.size());
+                noBlackjack = 1 - static_cast<double>(this->base[blackjackCard] - counts[blackjackCard]) / remainingTotal;
+
+            }
+
+            return weight * orderings * noBlackjack;
+
+        }
+
+    public:
+
+        // constructor
+        StrategySolver(Scoring scores, int deckCount) {
+
+            // set parameters
+            this->scores = scores;
+            this->deckCount = deckCount;
+
+            // fill fresh shoe
+            for (int v = 0; v < CARD_VALUE_COUNT; v ++) {
+
+                this->shoe[v] = CARD_SUITS * deckCount * ((v == CARD_VALUE_COUNT - 1) ? 4 : 1);
+
+            }
+
+            // clear table
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+                    for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+
+                        this->qTable[i][j][k] = 0;
+
+                    }
+                }
+            }
+
+            this->upcard = 0;
+            this->baseTotal = 0;
+            this->handTotal = 0;
+
+        }
+
+        // solve every cell of the table
+        void solve() {
+
+            // hands that land on each row
+            vector<vector<int>> rowHands[PLAYER_HAND_COUNT];
+            findRowHands(rowHands);
+
+            // iterate through dealer upcards
+            for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+
+                // stand, hit and double for every row
+                this->setBase(j + 1, -1);
+                for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+                    // weighted average over the hands in the row
+                    double totalWeight = 0;
+                    double values[ACTION_TYPE_COUNT] = {0};
+                    for (unsigned int h = 0; h < rowHands[i].size(); h ++) {
+
+                        const vector<int>& cards = rowHands[i].at(h);
+                        double weight = this->handWeight(cards);
+                        if (weight == 0) {
+                            continue;
+                        }
+
+                        // put hand in place
+                        int hardSum = 0;
+                        bool hasAce = false;
+                        for (unsigned int c = 0; c < cards.size(); c ++) {
+
+                            this->pushCard(cards.at(c) - 1);
+                            hardSum += cards.at(c);
+                            hasAce = hasAce || cards.at(c) == 1;
+
+                        }
+
+                        values[STAND] += weight * this->standValue(hardSum, hasAce, this->scores.win, this->scores.loss);
+                        values[HIT] += weight * ((hardSum == 21) ? this->scores.loss : this->hitValue(hardSum, hasAce));
+                        values[DOUBLE] += weight * this->doubleValue(hardSum, hasAce);
+                        totalWeight += weight;
+
+                        // take hand back out
+                        for (unsigned int c = 0; c < cards.size(); c ++) {
+                            this->popCard(cards.at(c) - 1);
+                        }
+
+                    }
+
+                    for (int k = 0; k < SPLIT; k ++) {
+                        this->qTable[i][j][k] = (totalWeight > 0) ? values[k] / totalWeight : 0;
+                    }
+
+                }
+
+                // split for every pair row
+                for (int i = TABLE_FIRST_PAIR_INDEX; i < PLAYER_HAND_COUNT; i ++) {
+
+                    // pair card index, the other pair card is in the other hand
+                    int c = i - TABLE_FIRST_PAIR_INDEX;
+                    this->setBase(j + 1, c);
+                    this->qTable[i][j][SPLIT] = 2 * this->splitHandValue(c);
+
+                }
+
+            }
+
+        }
+
+        // get table
+        double (*getQTable())[DEALER_HAND_COUNT][ACTION_TYPE_COUNT] {
+            return this->qTable;
+        }
+
+};
+
+#endif
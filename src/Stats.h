@@ -0,0 +1,231 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: running mean, variance and histograms that can be merged across threads
+*/
+
+// file guards
+#ifndef STATS_H
+#define STATS_H
+
+// imports
+#include <cmath>
+#include <vector>
+#include <limits>
+
+// namespace
+using std::sqrt;
+using std::vector;
+using std::numeric_limits;
+
+// mean and variance kept one sample at a time with Welford's method
+class RunningStats {
+
+    private:
+
+        // samples, mean and sum of squared differences from the mean
+        long long count;
+        double mean;
+        double m2;
+
+    public:
+
+        // constructor
+        RunningStats() {
+
+            this->count = 0;
+            this->mean = 0;
+            this->m2 = 0;
+
+        }
+
+        // add a sample
+        void add(double x) {
+
+            this->count ++;
+            double delta = x - this->mean;
+            this->mean += delta / this->count;
+            this->m2 += delta * (x - this->mean);
+
+        }
+
+        // add all of another set of samples (Chan's parallel update)
+        // merging in the same order always gives the same result
+        void merge(const RunningStats& other) {
+
+            if (other.count == 0) {
+                return;
+            }
+            if (this->count == 0) {
+                *this = other;
+                return;
+            }
+
+            long long total = this->count + other.count;
+            double delta = other.mean - this->mean;
+            this->mean += delta * other.count / total;
+            this->m2 += other.m2 + delta * delta * (static_cast<double>(this->count) * other.count / total);
+            this->count = total;
+
+        }
+
+        // number of samples
+        long long getCount() const {
+            return this->count;
+        }
+
+        // sample mean
+        double getMean() const {
+            return this->mean;
+        }
+
+        // sample variance
+        double getVariance() const {
+            return (this->count > 1) ? this->m2 / (this->count - 1) : 0;
+        }
+
+        // standard error of the mean
+        double getStandardError() const {
+            return (this->count > 1) ? sqrt(this->getVariance() / this->count) : 0;
+        }
+
+};
+
+// fixed bins between a low and high value with counts below and above them
+// memory stays the same for any number of samples, and quantiles are
+// read by interpolating inside the bin they land in
+class Histogram {
+
+    private:
+
+        // bin range
+        double low;
+        double high;
+        double binWidth;
+
+        // counts
+        vector<long long> bins;
+        long long below;
+        long long above;
+
+        // exact stats next to the bins
+        RunningStats stats;
+        double minimum;
+        double maximum;
+
+    public:
+
+        // constructor
+        Histogram() : Histogram(0, 1, 1) {}
+        Histogram(double low, double high, int binCount) {
+
+            this->low = low;
+            this->high = high;
+            this->binWidth = (high - low) / binCount;
+            this->bins = vector<long long>(binCount, 0);
+            this->below = 0;
+            this->above = 0;
+            this->minimum = numeric_limits<double>::infinity();
+            this->maximum = -numeric_limits<double>::infinity();
+
+        }
+
+        // add a sample
+        void add(double x) {
+
+            this->stats.add(x);
+            if (x < this->minimum) {
+                this->minimum = x;
+            }
+            if (x > this->maximum) {
+                this->maximum = x;
+            }
+
+            if (x < this->low) {
+                this->below ++;
+            }
+            else if (x >= this->high) {
+                this->above ++;
+            }
+            else {
+
+                int bin = (x - this->low) / this->binWidth;
+                if (bin >= static_cast<int>(this->bins.size())) {
+                    bin = this->bins.size() - 1;
+                }
+                this->bins[bin] ++;
+
+            }
+
+        }
+
+        // add all of another histogram with the same bins
+        void merge(const Histogram& other) {
+
+            this->stats.merge(other.stats);
+            if (other.minimum < this->minimum) {
+                this->minimum = other.minimum;
+            }
+            if (other.maximum > this->maximum) {
+                this->maximum = other.maximum;
+            }
+            this->below += other.below;
+            this->above += other.above;
+            for (unsigned int b = 0; b < this->bins.size(); b ++) {
+                this->bins[b] += other.bins[b];
+            }
+
+        }
+
+        // value below which a share q of the samples fall
+        // samples outside the bins are placed between the bin edge and the min or max
+        double getQuantile(double q) const {
+
+            long long count = this->stats.getCount();
+            if (count == 0) {
+                return 0;
+            }
+
+            // rank of the quantile
+            double rank = q * count;
+
+            // below the bins
+            if (this->below > 0 && rank <= this->below) {
+                return this->minimum + (this->low - this->minimum) * rank / this->below;
+            }
+            double seen = this->below;
+
+            // inside a bin
+            for (unsigned int b = 0; b < this->bins.size(); b ++) {
+
+                if (rank <= seen + this->bins[b] && this->bins[b] > 0) {
+
+                    double value = this->low + this->binWidth * (b + (rank - seen) / this->bins[b]);
+                    return (value < this->minimum) ? this->minimum : (value > this->maximum) ? this->maximum : value;
+
+                }
+                seen += this->bins[b];
+
+            }
+
+            // above the bins
+            return (this->above == 0) ? this->maximum : this->high + (this->maximum - this->high) * (rank - seen) / this->above;
+
+        }
+
+        // exact mean and variance
+        const RunningStats& getStats() const {
+            return this->stats;
+        }
+
+        // smallest and largest sample
+        double getMin() const {
+            return this->minimum;
+        }
+        double getMax() const {
+            return this->maximum;
+        }
+
+};
+
+#endif
@@ -0,0 +1,191 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: scoped timing zones written out as a chrome trace
+*/
+
+// file guards
+#ifndef TRACE_H
+#define TRACE_H
+
+// tracing is off unless built with -DBJ_TRACE=1
+// when off every zone and write compiles to nothing
+#ifndef BJ_TRACE
+#define BJ_TRACE 0
+#endif
+
+#if BJ_TRACE
+
+// imports
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+
+// namespace
+using std::string;
+using std::vector;
+using std::ofstream, std::endl;
+using std::mutex, std::lock_guard;
+using std::atomic;
+using std::chrono::steady_clock, std::chrono::duration;
+
+// one finished zone
+struct TraceEvent {
+
+    // zone name, always a string literal
+    const char* name;
+
+    // number shown with the zone (chunk, batch...), -1 for none
+    long long arg;
+
+    // thread it ran on
+    int thread;
+
+    // start and length in microseconds since the program started
+    double start;
+    double length;
+
+};
+
+// time every zone is measured from
+const steady_clock::time_point traceEpoch = steady_clock::now();
+
+// zones of finished threads, added to under a lock when a thread ends
+mutex traceLock;
+vector<TraceEvent> finishedTraceEvents;
+
+// threads numbered in the order they first trace something
+atomic<int> nextTraceThread(0);
+
+// one thread's zones
+// zones are kept in a plain vector and handed over when the thread ends
+struct TraceBuffer {
+
+    int thread;
+    vector<TraceEvent> events;
+
+    TraceBuffer() {
+
+        this->thread = nextTraceThread ++;
+        this->events.reserve(4096);
+
+    }
+
+    ~TraceBuffer() {
+
+        lock_guard<mutex> guard(traceLock);
+        finishedTraceEvents.insert(finishedTraceEvents.end(), this->events.begin(), this->events.end());
+
+    }
+
+};
+thread_local TraceBuffer traceBuffer;
+
+// microseconds since the program started
+double traceMicros(steady_clock::time_point time) {
+
+    return duration<double, std::micro>(time - traceEpoch).count();
+
+}
+
+// times the scope it lives in
+class TraceZone {
+
+    private:
+
+        // zone name and number
+        const char* name;
+        long long arg;
+
+        // when the scope started
+        steady_clock::time_point start;
+
+    public:
+
+        // constructor, starts timing
+        TraceZone(const char* name, long long arg = -1) {
+
+            this->name = name;
+            this->arg = arg;
+            this->start = steady_clock::now();
+
+        }
+
+        // destructor, keeps the zone on this thread
+        ~TraceZone() {
+
+            steady_clock::time_point end = steady_clock::now();
+            traceBuffer.events.push_back({
+                this->name,
+                this->arg,
+                traceBuffer.thread,
+                traceMicros(this->start),
+                duration<double, std::micro>(end - this->start).count()
+            });
+
+        }
+
+        // one zone per scope
+        TraceZone(const TraceZone&) = delete;
+        TraceZone& operator=(const TraceZone&) = delete;
+
+};
+
+// writes every finished thread's zones and the calling thread's as a chrome trace
+// (chrome://tracing or ui.perfetto.dev), worker threads have to be joined first
+bool writeTrace(const string& path) {
+
+    lock_guard<mutex> guard(traceLock);
+
+    vector<TraceEvent> events = finishedTraceEvents;
+    events.insert(events.end(), traceBuffer.events.begin(), traceBuffer.events.end());
+    int threadCount = nextTraceThread;
+
+    ofstream outfile(path);
+    outfile << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << endl;
+
+    // thread names
+    for (int t = 0; t < threadCount; t ++) {
+        outfile << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << t << ", \"args\": {\"name\": \"thread " << t << "\"}}," << endl;
+    }
+
+    // complete events
+    outfile << std::fixed;
+    for (unsigned int e = 0; e < events.size(); e ++) {
+
+        const TraceEvent& event = events.at(e);
+        outfile << "{\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.thread;
+        outfile << ", \"ts\": " << event.start << ", \"dur\": " << event.length;
+        if (event.arg != -1) {
+            outfile << ", \"args\": {\"n\": " << event.arg << "}";
+        }
+        outfile << "}" << ((e + 1 < events.size()) ? "," : "") << endl;
+
+    }
+    outfile << "]}" << endl;
+
+    return outfile.good();
+
+}
+
+// time the rest of the scope, with an optional number
+#define BJ_TRACE_JOIN_NAME(a, b) a##b
+#define BJ_TRACE_NAME(a, b) BJ_TRACE_JOIN_NAME(a, b)
+#define BJ_TRACE_ZONE(name) TraceZone BJ_TRACE_NAME(traceZone, __LINE__)(name)
+#define BJ_TRACE_ZONE_ARG(name, arg) TraceZone BJ_TRACE_NAME(traceZone, __LINE__)(name, arg)
+
+// write the trace file
+#define BJ_TRACE_WRITE(path) writeTrace(path)
+
+#else
+
+#define BJ_TRACE_ZONE(name)
+#define BJ_TRACE_ZONE_ARG(name, arg)
+#define BJ_TRACE_WRITE(path)
+
+#endif
+
+#endif
@@ -0,0 +1,276 @@
+/*
+    Author: Franklin Doane
+    Date created: 18 October 2026
+    Purpose: plays training games for the q learning agent
+*/
+
+// file guards
+#ifndef TRAINING_H
+#define TRAINING_H
+
+// imports
+#include <vector>
+#include <utility>
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "ExploringStarts.h"
+
+// namespace
+using std::vector, std::pair;
+
+// plays one training game and every branch split off of it
+// results are handed to the agent, splits is a reusable holding list for split branches
+void playTrainingGame(Game* game, BlackJackAgent* agent, StartSampler* sampler, StartMode startMode, double exploringStartsRate, vector<SplitInfo>& splits) {
+
+    BJ_ALLOC_SCOPE(ALLOC_HAND_LOOP);
+
+    // game status
+    bool gameOver;
+
+    // exploring starts status
+    bool forceFirstMove;
+    pair<int, int> startCell;
+
+    // player move
+    ActionType agentMove;
+
+    // split branch being set up or played
+    SplitInfo split;
+
+    // split histories of the last game are done with
+    agent->clearSplitHistory();
+
+    // check for exploring start
+    forceFirstMove = startMode != NATURAL_STARTS && sampler->roll(exploringStartsRate);
+
+    // deal game
+    if (forceFirstMove) {
+
+        // deal picked chart cell
+        startCell = sampler->sampleCell();
+        gameOver = game->dealStartingHands(sampler->sampleHand(startCell.first), startCell.second + 1);
+
+    }
+    else {
+
+        gameOver = game->dealHands();
+
+    }
+
+    // set default agent move for iteration
+    agentMove = HIT;
+
+    // while the game isn't over and player isn't done making moves
+    while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
+
+        //cout << "In game" << endl;
+
+        // get player moves
+        if (forceFirstMove) {
+
+            // random allowed first action for exploring start
+            agentMove = agent->forceMove(game->getState(), sampler->sampleAction(legalActions(game->getState())));
+            forceFirstMove = false;
+
+        }
+        else {
+
+            agentMove = agent->makeMove(game->getState());
+
+        }
+
+        //cout << "agent move made" << endl;
+
+        // carry out agent move
+        switch (agentMove) {
+            
+            // agent hit
+            case HIT:
+                //cout << "hit" << endl;
+
+                // hit in game
+                gameOver = game->hit();
+                break;
+
+            case SPLIT:
+                //cout << "split" << endl;
+
+                // add split info to split list to play other side of game
+                split = {
+                    game->getState().playerCards.at(0),
+                    game->getState().dealerShowing,
+                    game->getDealerSecondCard(),
+                    0,
+                    0
+                };
+                agent->saveSplitHistory(split.historyStart, split.historyLength);
+                splits.push_back(split);
+
+                // setup this half of the game
+                game->runSplit();
+
+                break;
+
+            // agent double 
+            case DOUBLE:
+                //cout << "double" << endl;
+
+                // double bet in game
+                game->doubleBet();
+
+                // take hit
+                gameOver = game->hit();
+                break;
+
+            // agent stand
+            case STAND:
+                //cout << "stand" << endl;
+
+                break;
+
+            // the agent only picks the four base actions
+            default:
+
+                break;
+
+        }
+
+    }
+
+    //cout << "player played" << endl;
+
+    // player dealer turn if game isn't over
+    if (!gameOver) {
+
+        game->playDealer();
+
+    }
+    //cout << "dealer played" << endl;
+
+    // set reward for game results
+    agent->endGame(game->getScore());
+
+    // reset game
+    game->reset();
+    
+    // run other branches of split game
+    while (splits.size() > 0) {
+
+        // play split game
+
+        // fetch split data
+        split = splits.back();
+        splits.pop_back();
+
+        // deal game
+        game->setupSplit(split.playerCard, split.dealerCard1, split.dealerCard2);
+
+        // set game history
+        agent->restoreSplitHistory(split.historyStart, split.historyLength);
+
+        // deal player second card
+        game->hit();
+
+        // set default agent move for iteration
+        agentMove = HIT;
+
+        // while the game isn't over and player isn't done making moves
+        while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
+
+            // get player moves
+            agentMove = agent->makeMove(game->getState());
+
+            // carry out agent move
+            switch (agentMove) {
+                
+                // agent hit
+                case HIT:
+                    
+                    // hit in game
+                    gameOver = game->hit();
+                    break;
+
+                case SPLIT:
+
+                    // add split info to split list
+                    split = {
+                        game->getState().playerCards.at(0),
+                        game->getState().dealerShowing,
+                        game->getDealerSecondCard(),
+                        0,
+                        0
+                    };
+                    agent->saveSplitHistory(split.historyStart, split.historyLength);
+                    splits.push_back(split);
+
+                    // setup first half of game
+                    game->runSplit();
+
+                    break;
+
+                // agent double 
+                case DOUBLE:
+
+                    // double bet in game
+                    game->doubleBet();
+
+                    // take hit
+                    gameOver = game->hit();
+                    break;
+
+                // agent stand
+                case STAND:
+                    break;
+
+                // the agent only picks the four base actions
+                default:
+
+                    break;
+
+            }
+
+        }
+
+        // player dealer turn if game isn't over
+        if (!gameOver) {
+
+            game->playDealer();
+
+        }
+
+        // set reward for game results
+        agent->endGame(game->getScore());
+
+        // reset game
+        game->reset();
+
+    }
+
+}
+
+// trains the agent on the games played so far and re-weights exploring starts
+void trainAgent(BlackJackAgent* agent, StartSampler* sampler, StartMode startMode) {
+
+    // cell weights for adaptive starts
+    double startWeights[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+
+    // update q tables
+    agent->train();
+
+    // point weighted starts at the least trained cells
+    if (startMode == WEIGHTED_STARTS) {
+
+        sampler->setWeightsFromCounts(agent->getQTableCounts());
+
+    }
+    // point adaptive starts at the most undecided cells
+    else if (startMode == ADAPTIVE_STARTS) {
+
+        agent->getUndecidedWeights(startWeights);
+        sampler->setWeights(startWeights);
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*
+    Author: Franklin Doane
+    Date Created: 18 October 2026
+    Purpose: times the simulator's hot paths and writes the results as json
+*/
+
+// imports
+#include "HotPaths.h"
+#include "Options.h"
+#include <iostream>
+#include <ctime>
+
+// namespace
+using std::cout, std::endl;
+using std::to_string;
+using std::time;
+
+// main
+// usage: bench.exe [label] [--out path] [--filter text] [--warmup seconds] [--rep-time seconds] [--reps n]
+// writes Bench_<label>.json, or the --out path, with ns/op, allocations/op and items/sec
+int main(int argc, char* argv[]) {
+
+    // label of the run
+    const string LABEL = (argc > 1 && string(argv[1]).compare(0, 2, "--") != 0) ? argv[1] : to_string(time(0));
+
+    // output file
+    string outPath = "Bench_" + LABEL + ".json";
+    readOption(argc, argv, "out", outPath);
+
+    // only run benchmarks with this in their name
+    string filter;
+    readOption(argc, argv, "filter", filter);
+
+    // timing
+    const BenchConfig CONFIG = {
+        readNumberOption(argc, argv, "warmup", DEFAULT_WARMUP_SECONDS),
+        readNumberOption(argc, argv, "rep-time", DEFAULT_REPETITION_SECONDS),
+        static_cast<int>(readNumberOption(argc, argv, "reps", DEFAULT_REPETITIONS))
+    };
+    if (CONFIG.repetitions < 1 || CONFIG.repetitionSeconds <= 0) {
+
+        cout << "--reps and --rep-time have to be positive" << endl;
+        return 1;
+
+    }
+
+    cout << "Running benchmarks..." << endl << endl;
+    vector<BenchResult> results = runHotPathBenchmarks(CONFIG, filter);
+
+    // results
+    printBenchResults(results);
+    if (!writeBenchJson(outPath, LABEL, CONFIG, results)) {
+
+        cout << endl << "Can't write " << outPath << endl;
+        return 1;
+
+    }
+    cout << endl << "Results written to " << outPath << endl;
+
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+    Author: Franklin Doane
+    Date Created: 18 October 2026
+    Purpose: checks readable charts and writes their packed .bin and constexpr header forms
+*/
+
+// imports
+#include "BlackJackAgent.h"
+#include "ChartIO.h"
+#include "CompiledChart.h"
+#include "Options.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cctype>
+
+// namespace
+using std::cout, std::endl;
+using std::hex, std::dec, std::setw, std::setfill;
+using std::toupper, std::isalnum;
+
+// values per line in the header
+const int HEADER_VALUES_PER_LINE = DEALER_HAND_COUNT;
+
+// name of the header array for a chart id
+string headerArrayName(const string& chartId) {
+
+    string name = "CHART_";
+    for (char c : chartId) {
+        name += isalnum(static_cast<unsigned char>(c)) ? toupper(static_cast<unsigned char>(c)) : '_';
+    }
+
+    return name;
+
+}
+
+// writes the packed chart as a constexpr array in a header
+bool writeCompiledHeader(const string& path, const string& chartId, const CompiledChart& compiled) {
+
+    const string NAME = headerArrayName(chartId);
+
+    ofstream outfile(path);
+    outfile << "/*" << endl;
+    outfile << "    Compiled from Chart" << chartId << "_readable.csv by chartc" << endl;
+    outfile << "    Purpose: Chart" << chartId << " built into a program, read with compiledMove" << endl;
+    outfile << "    Each byte is a chart cell, rows then columns, low 4 bits are the action for a" << endl;
+    outfile << "    2 card hand and high 4 bits the action once the hand has more cards" << endl;
+    outfile << "*/" << endl << endl;
+    outfile << "// file guards" << endl;
+    outfile << "#ifndef " << NAME << "_H" << endl;
+    outfile << "#define " << NAME << "_H" << endl << endl;
+    outfile << "constexpr unsigned char " << NAME << "[" << COMPILED_CHART_SIZE << "] = {" << endl << endl;
+
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+
+        outfile << "    ";
+        for (int j = 0; j < HEADER_VALUES_PER_LINE; j ++) {
+            outfile << "0x" << hex << setw(2) << setfill('0') << static_cast<int>(compiled.cells[i * DEALER_HAND_COUNT + j]) << dec << ", ";
+        }
+        outfile << "// " << PLAYER_HANDS[i] << endl;
+
+    }
+
+    outfile << endl << "};" << endl << endl;
+    outfile << "#endif" << endl;
+
+    return outfile.good();
+
+}
+
+// checks and compiles one chart
+// returns false with the reason if it can't
+bool compileChartId(const string& chartId, string& error) {
+
+    const string readablePath = readableChartPath(chartId);
+    const string compiledPath = compiledChartPath(chartId);
+    const string headerPath = "../charts/Chart" + chartId + "/Chart" + chartId + "_compiled.h";
+
+    // read and check readable chart
+    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+    try {
+
+        if (!loadChart(readablePath, chart)) {
+
+            error = "can't open " + readablePath;
+            return false;
+
+        }
+
+    }
+    catch (const invalid_argument&) {
+
+        error = "bad value in " + readablePath;
+        return false;
+
+    }
+    catch (const out_of_range&) {
+
+        error = "bad value in " + readablePath;
+        return false;
+
+    }
+    if (!validateChart(chart, error)) {
+        return false;
+    }
+
+    // pack and write both forms
+    CompiledChart compiled;
+    compileChart(chart, compiled);
+    if (!writeCompiledChart(compiledPath, compiled)) {
+
+        error = "can't write " + compiledPath;
+        return false;
+
+    }
+    if (!writeCompiledHeader(headerPath, chartId, compiled)) {
+
+        error = "can't write " + headerPath;
+        return false;
+
+    }
+
+    // read packed file back to make sure it matches
+    CompiledChart check;
+    if (!loadCompiledChart(compiledPath, check)) {
+
+        error = "can't read back " + compiledPath;
+        return false;
+
+    }
+    for (int c = 0; c < COMPILED_CHART_SIZE; c ++) {
+
+        if (check.cells[c] != compiled.cells[c]) {
+
+            error = "read back mismatch in " + compiledPath;
+            return false;
+
+        }
+
+    }
+
+    return true;
+
+}
+
+// main
+// usage: chartc.exe <chart id> [<chart id> ...]
+//        chartc.exe --all
+// writes Chart<id>.bin and Chart<id>_compiled.h next to each readable chart
+int main(int argc, char* argv[]) {
+
+    // charts to compile
+    vector<string> chartIds;
+    if (hasFlag(argc, argv, "all")) {
+
+        chartIds = findChartIds("../charts");
+
+    }
+    else {
+
+        for (int i = 1; i < argc; i ++) {
+            chartIds.push_back(argv[i]);
+        }
+
+    }
+    if (chartIds.empty()) {
+
+        cout << "usage: chartc.exe <chart id> [<chart id> ...] | --all" << endl;
+        return 1;
+
+    }
+
+    // compile each, keep going past bad ones
+    int failures = 0;
+    string error;
+    for (unsigned int c = 0; c < chartIds.size(); c ++) {
+
+        if (compileChartId(chartIds.at(c), error)) {
+
+            cout << "Chart" << chartIds.at(c) << ": ok" << endl;
+
+        }
+        else {
+
+            cout << "Chart" << chartIds.at(c) << ": " << error << endl;
+            failures ++;
+
+        }
+
+    }
+
+    return (failures > 0) ? 1 : 0;
+}
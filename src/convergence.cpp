@@ -0,0 +1,336 @@
+/*
+    Author: Franklin Doane
+    Date Created: 18 October 2026
+    Purpose: compare how many training games each step size schedule and update target
+             needs for a stable chart and for agreeing with a target chart
+*/
+
+// imports
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "ExploringStarts.h"
+#include "Training.h"
+#include "ChartIO.h"
+#include "Solver.h"
+#include "Options.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <chrono>
+
+// namespace
+using std::cout, std::endl;
+using std::setw, std::left, std::right;
+using std::exp;
+using std::srand;
+using std::chrono::steady_clock, std::chrono::duration;
+
+// CONSTANT TRAINING PARAMETERS
+// same as driver.cpp
+const double E_COEFFICIENT = 6e-7;
+const double E_RIGHT_SHIFT = 4;
+const auto EPSILON = [](int x) -> double {return (1 / (1 + exp(E_COEFFICIENT*x - E_RIGHT_SHIFT)));};
+const float GAMMA = 1.0;
+const float ALPHA = 4e-3;
+const int TRAIN_EVERY = 2000;
+
+// CONSTANT BLACKJACK GAME PARAMETERS
+const int DECK_COUNT = 4;
+const int SHUFFLE_EVERY_N_DECKS = 2;
+const Scoring SCORES = {
+
+    1.5,  // blackjack;
+    2,    // doubleWin;
+    1,    // win;
+    -1,   // loss;
+    -2,   // doubleLoss;
+    0     // push;
+
+};
+
+// stability check defaults
+// the chart is stable once it changes in at most the stable cell changes
+// between checks for STABLE_CHECKS checks in a row
+const int DEFAULT_MAX_GAMES = 8e6;
+const int DEFAULT_CHECK_EVERY = 100000;
+const int DEFAULT_STABLE_CELL_CHANGES = 5;
+const int STABLE_CHECKS = 5;
+
+// share of cells that have to match the target chart
+const double DEFAULT_AGREEMENT = 0.9;
+
+// replay minibatch size
+const int REPLAY_BATCH = 256;
+
+// training setup being compared
+struct ConvergenceConfig {
+
+    // name in the results table
+    string label;
+
+    // agent settings
+    AlphaSchedule schedule;
+    UpdateTarget target;
+
+};
+
+// result of training one schedule
+struct ConvergenceResult {
+
+    // games until the chart was stable, -1 if it never was
+    int stableGames;
+
+    // cells changed at the last check
+    int lastChanges;
+
+    // games until the chart matched the target chart, -1 if it never did
+    int targetGames;
+
+    // share of cells matching the target chart at the last check
+    double agreement;
+
+    // wall time in seconds
+    double seconds;
+
+};
+
+// benchmark settings shared by every run
+struct ConvergenceSettings {
+
+    int maxGames;
+    int checkEvery;
+    int stableChanges;
+    double agreement;
+    double alphaPower;
+    double lambda;
+    unsigned int seed;
+
+    // replay memory, buffer size 0 is off
+    int replaySize;
+    double replayRatio;
+    double replayPriority;
+
+};
+
+// trains a fresh agent until its chart is stable and matches the target, or games run out
+ConvergenceResult runConfig(const ConvergenceConfig& config, const ConvergenceSettings& settings, const int targetChart[][DEALER_HAND_COUNT]) {
+
+    // unpack settings
+    const int maxGames = settings.maxGames;
+    const int checkEvery = settings.checkEvery;
+    const int stableChanges = settings.stableChanges;
+    const unsigned int seed = settings.seed;
+
+    // same random streams for every schedule
+    Dealer* dealer = new Dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, seed);
+    Game* game = new Game(dealer, SCORES);
+    BlackJackAgent* agent = new BlackJackAgent(EPSILON, GAMMA, ALPHA);
+    agent->setAlphaSchedule(config.schedule, settings.alphaPower);
+    agent->setUpdateTarget(config.target, settings.lambda);
+    if (settings.replaySize > 0) {
+        agent->setReplay(settings.replaySize, settings.replayRatio, REPLAY_BATCH, settings.replayPriority);
+    }
+    StartSampler* sampler = new StartSampler(seed);
+    vector<SplitInfo> splits;
+
+    // agent seeds rand with the time, reseed after it
+    srand(seed);
+
+    // charts at the last and current check
+    int lastChart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT] = {};
+    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+
+    // stability tracking
+    ConvergenceResult result = {-1, -1, -1, 0, 0};
+    int stableStreak = 0;
+    int streakStart = 0;
+
+    steady_clock::time_point start = steady_clock::now();
+    for (int gameNum = 0; gameNum < maxGames; gameNum ++) {
+
+        // play and train like the driver
+        playTrainingGame(game, agent, sampler, NATURAL_STARTS, 0, splits);
+        if (gameNum % TRAIN_EVERY == 0) {
+            trainAgent(agent, sampler, NATURAL_STARTS);
+        }
+
+        // check chart
+        if ((gameNum + 1) % checkEvery == 0) {
+
+            buildChart(agent->getQTable(), chart);
+            result.lastChanges = chartDifference(lastChart, chart);
+
+            // agreement with the target chart
+            result.agreement = 1 - static_cast<double>(chartDifference(targetChart, chart)) / (PLAYER_HAND_COUNT * DEALER_HAND_COUNT);
+            if (result.targetGames == -1 && result.agreement >= settings.agreement) {
+                result.targetGames = gameNum + 1;
+            }
+
+            // count checks in a row with few changes
+            if (result.lastChanges <= stableChanges) {
+
+                if (stableStreak == 0) {
+                    streakStart = gameNum + 1 - checkEvery;
+                }
+                stableStreak ++;
+
+            }
+            else {
+
+                stableStreak = 0;
+
+            }
+
+            // keep chart for next check
+            for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+                for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+                    lastChart[i][j] = chart[i][j];
+                }
+            }
+
+            // stable
+            if (result.stableGames == -1 && stableStreak >= STABLE_CHECKS) {
+                result.stableGames = streakStart;
+            }
+
+            // stable and matching, stop training
+            if (result.stableGames != -1 && result.targetGames != -1) {
+                break;
+            }
+
+        }
+
+    }
+    result.seconds = duration<double>(steady_clock::now() - start).count();
+
+    // cleanup
+    delete sampler;
+    delete agent;
+    delete game;
+    delete dealer;
+
+    return result;
+
+}
+
+// prints a game count or a dash if it never happened
+void printGames(int games) {
+
+    if (games == -1) {
+        cout << setw(14) << "-";
+    }
+    else {
+        cout << setw(14) << games;
+    }
+
+}
+
+// main
+// usage: convergence.exe [--sweep schedules|targets] [--target-chart readable.csv] [--agreement a]
+//                        [--max-games n] [--check-every n] [--stable-changes n]
+//                        [--alpha-schedule name] [--alpha-power p] [--lambda l] [--seed s]
+//                        [--replay-size games] [--replay-ratio r] [--replay-priority exponent]
+// without a target chart the exact infinite deck solver chart is the target
+int main(int argc, char* argv[]) {
+
+    // benchmark settings
+    ConvergenceSettings settings;
+    settings.maxGames = readNumberOption(argc, argv, "max-games", DEFAULT_MAX_GAMES);
+    settings.checkEvery = readNumberOption(argc, argv, "check-every", DEFAULT_CHECK_EVERY);
+    settings.stableChanges = readNumberOption(argc, argv, "stable-changes", DEFAULT_STABLE_CELL_CHANGES);
+    settings.agreement = readNumberOption(argc, argv, "agreement", DEFAULT_AGREEMENT);
+    settings.alphaPower = readNumberOption(argc, argv, "alpha-power", 0.7);
+    settings.lambda = readNumberOption(argc, argv, "lambda", 0.8);
+    settings.seed = readNumberOption(argc, argv, "seed", time(0));
+    settings.replaySize = readNumberOption(argc, argv, "replay-size", 0);
+    settings.replayRatio = readNumberOption(argc, argv, "replay-ratio", 4);
+    settings.replayPriority = readNumberOption(argc, argv, "replay-priority", 0);
+    if (settings.replayRatio < 0) {
+
+        cout << "--replay-ratio can't be negative" << endl;
+        return 1;
+
+    }
+
+    // what to compare
+    string sweep = "schedules";
+    readOption(argc, argv, "sweep", sweep);
+
+    // schedule used when sweeping update targets
+    string scheduleName = ALPHA_SCHEDULE_NAMES[CONSTANT_ALPHA];
+    readOption(argc, argv, "alpha-schedule", scheduleName);
+    int schedule = findName(ALPHA_SCHEDULE_NAMES, ALPHA_SCHEDULE_COUNT, scheduleName);
+    if (schedule == -1) {
+
+        cout << "Unknown alpha schedule: " << scheduleName << endl;
+        return 1;
+
+    }
+
+    // build runs
+    vector<ConvergenceConfig> configs;
+    if (sweep == "schedules") {
+
+        for (int s = 0; s < ALPHA_SCHEDULE_COUNT; s ++) {
+            configs.push_back({ALPHA_SCHEDULE_NAMES[s], static_cast<AlphaSchedule>(s), ONE_STEP_Q});
+        }
+
+    }
+    else if (sweep == "targets") {
+
+        for (int t = 0; t < UPDATE_TARGET_COUNT; t ++) {
+            configs.push_back({UPDATE_TARGET_NAMES[t], static_cast<AlphaSchedule>(schedule), static_cast<UpdateTarget>(t)});
+        }
+
+    }
+    else {
+
+        cout << "Unknown sweep: " << sweep << endl;
+        return 1;
+
+    }
+
+    // target chart from a file or the solver
+    int targetChart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+    string targetPath;
+    if (readOption(argc, argv, "target-chart", targetPath)) {
+
+        if (!loadChart(targetPath, targetChart)) {
+
+            cout << "Can't open target chart: " << targetPath << endl;
+            return 1;
+
+        }
+
+    }
+    else {
+
+        StrategySolver solver(SCORES, 0);
+        solver.solve();
+        buildChart(solver.getQTable(), targetChart);
+        targetPath = "exact solver, infinite deck";
+
+    }
+
+    cout << "Stable chart: <= " << settings.stableChanges << " cells changed for " << STABLE_CHECKS << " checks of " << settings.checkEvery << " games" << endl;
+    cout << "Target chart: " << targetPath << ", " << settings.agreement * 100 << "% of cells matching" << endl;
+    cout << "Seed: " << settings.seed << ", game limit: " << settings.maxGames << endl;
+    cout << "Replay: " << settings.replaySize << " games, ratio " << settings.replayRatio << ", priority exponent " << settings.replayPriority << endl << endl;
+    cout << left << setw(14) << "run" << right << setw(14) << "stable games" << setw(14) << "last changes" << setw(14) << "target games" << setw(12) << "agreement" << setw(12) << "seconds" << endl;
+
+    // run every config
+    for (unsigned int c = 0; c < configs.size(); c ++) {
+
+        ConvergenceResult result = runConfig(configs.at(c), settings, targetChart);
+
+        cout << left << setw(14) << configs.at(c).label << right;
+        printGames(result.stableGames);
+        cout << setw(14) << result.lastChanges;
+        printGames(result.targetGames);
+        cout << setw(12) << result.agreement << setw(12) << result.seconds << endl;
+
+    }
+
+    return 0;
+}
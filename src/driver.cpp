@@ -7,6 +7,17 @@
 // imports
 #include "BlackJack.h"
 #include "BlackJackAgent.h"
+#include "ExploringStarts.h"
+#include "ChartIO.h"
+#include "Training.h"
+#include "Options.h"
+#include "Logger.h"
+#include "Progress.h"
+#include "Counters.h"
+#include "Trace.h"
+#include "AllocTracker.h"
+#include "ResultsStore.h"
+#include "QLog.h"
 #include <iostream>
 #include <cmath>
 #include <fstream>
@@ -25,9 +36,34 @@ const double E_RIGHT_SHIFT = 4;
 const auto EPSILON = [](int x) -> double {return (1 / (1 + exp(E_COEFFICIENT*x - E_RIGHT_SHIFT)));};
 const float GAMMA = 1.0;
 const float ALPHA = 4e-3;
+const double DEFAULT_ALPHA_POWER = 0.7;
+const double DEFAULT_LAMBDA = 0.8;
+
+// replay defaults, a buffer size of 0 turns replay off
+const int DEFAULT_REPLAY_SIZE = 0;
+const double DEFAULT_REPLAY_RATIO = 4;
+const int DEFAULT_REPLAY_BATCH = 256;
+const double DEFAULT_REPLAY_PRIORITY = 0;
 const int GAME_COUNT = 14e6;
 const int TRAIN_EVERY = 2000;
 
+// training batches played before the alloc guard is armed, so lists have grown to size
+const int ALLOC_GUARD_WARMUP_BATCHES = 2;
+
+// split branches kept room for, more than a hand can ever have waiting
+const int MAX_PENDING_SPLITS = 32;
+
+// seconds between progress lines
+const double DEFAULT_PROGRESS_SECONDS = 5;
+
+// training batches between q log snapshots, 0 turns the log off
+const int DEFAULT_Q_LOG_BATCHES = 10;
+
+// exploring starts
+// games that start in a picked chart cell with a random forced first action
+const StartMode START_MODE = NATURAL_STARTS;
+const double EXPLORING_STARTS_RATE = 0.5;
+
 // note of what makes this chart unique
 const string CHART_NOTE = "56 repeat";
 
@@ -61,408 +97,195 @@ void printTable(Hands table, int dealer2nd) {
 }
 
 // main
+// usage: driver.exe <chart id> [--alpha-schedule constant|average|polynomial|clamped] [--alpha-power p]
+//                              [--update-target q|mc|lambda] [--lambda l]
+//                              [--replay-size games] [--replay-ratio r] [--replay-batch b] [--replay-priority exponent]
+//                              [--progress-seconds s] [--games n] [--qlog-batches n] [--alloc-guard]
+// --qlog-batches sets how many training batches go between q log snapshots, 0 turns the log off
+// --alloc-guard needs a -DBJ_ALLOC_TRACKING=1 build and fails the run if training games allocate
+// once the first few batches are done, training itself is left out
 int main(int argc, char* argv[]) {
 
     // chart names
+    // main chart files are named in writeChartFiles
     const string CHART_ID = argv[1];
-    const string CHART_NAME = "Chart" + CHART_ID + ".csv";
-
-    // chart that can be used by computer
-    const string USABLE_CHART_NAME = "Chart" + CHART_ID + "_readable.csv";
-
-    // chart saying training examples for each max q action
-    const string MAX_TRAINING_CHART_NAME = "Chart" + CHART_ID + "_backing.csv";
-
-    // chart saying all q values
-    const string Q_CHART_NAME = "Chart" + CHART_ID + "_Q.csv";
 
-    // chart saying all training examples
-    const string TRAINING_CHART_NAME = "Chart" + CHART_ID + "_wholeBacking.csv";
+    // chart saying the confidence interval on the gap between the two best actions
+    const string CI_CHART_NAME = "Chart" + CHART_ID + "_CI.csv";
 
     // text file containing all the parameters of creation
     const string PARAM_FILE_NAME = CHART_ID + "_parameters.txt";
 
-    // blackjack dealer
-    Dealer* dealer = new Dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS);
-
-    // blackjack game
-    Game* game = new Game(dealer, SCORES);
-
-    // initialize q learning agent
-    BlackJackAgent* agent = new BlackJackAgent(EPSILON, GAMMA, ALPHA);
-
-    // game status
-    bool gameOver;
-
-    // player move
-    ActionType agentMove;
-
-    // alternate game paths as held for split
-    vector<SplitInfo> splits;
-    SplitInfo split;
-
-    // iterate through games
-    cout << "Beginning training..." << endl;
-    for (int gameNum = 0; gameNum < GAME_COUNT; gameNum ++) {
-
-        // deal game
-        gameOver = game->dealHands();
-
-        // set default agent move for iteration
-        agentMove = HIT;
-
-        // while the game isn't over and player isn't done making moves
-        while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
-
-            //cout << "In game" << endl;
-
-            // get player moves
-            agentMove = agent->makeMove(game->getState());
-
-            //cout << "agent move made" << endl;
-
-            // carry out agent move
-            switch (agentMove) {
-                
-                // agent hit
-                case HIT:
-                    //cout << "hit" << endl;
-
-                    // hit in game
-                    gameOver = game->hit();
-                    break;
-
-                case SPLIT:
-                    //cout << "split" << endl;
-
-                    // add split info to split list to play other side of game
-                    split = {
-                        game->getState().playerCards.at(0),
-                        game->getState().dealerShowing,
-                        game->getDealerSecondCard(),
-                        agent->getGameActions()
-                    };
-                    splits.push_back(split);
-
-                    // setup this half of the game
-                    game->runSplit();
-
-                    break;
-
-                // agent double 
-                case DOUBLE:
-                    //cout << "double" << endl;
-
-                    // double bet in game
-                    game->doubleBet();
-
-                    // take hit
-                    gameOver = game->hit();
-                    break;
-
-                // agent stand
-                case STAND:
-                    //cout << "stand" << endl;
-
-                    break;
-
-            }
-
-        }
-
-        //cout << "player played" << endl;
-
-        // player dealer turn if game isn't over
-        if (!gameOver) {
-
-            game->playDealer();
-
-        }
-        //cout << "dealer played" << endl;
-
-        // set reward for game results
-        agent->endGame(game->getScore());
-
-        // reset game
-        game->reset();
-        
-        // run other branches of split game
-        while (splits.size() > 0) {
-
-            // play split game
-
-            // fetch split data
-            split = splits.back();
-            splits.pop_back();
-
-            // deal game
-            game->setupSplit(split.playerCard, split.dealerCard1, split.dealerCard2);
-
-            // set game history
-            agent->setGameActions(split.actionHistory);
-
-            // deal player second card
-            game->hit();
-
-            // set default agent move for iteration
-            agentMove = HIT;
-
-            // while the game isn't over and player isn't done making moves
-            while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
-
-                // get player moves
-                agentMove = agent->makeMove(game->getState());
+    // step size schedule picked at runtime
+    string scheduleName = ALPHA_SCHEDULE_NAMES[CONSTANT_ALPHA];
+    readOption(argc, argv, "alpha-schedule", scheduleName);
+    const int ALPHA_SCHEDULE = findName(ALPHA_SCHEDULE_NAMES, ALPHA_SCHEDULE_COUNT, scheduleName);
+    const double ALPHA_POWER = readNumberOption(argc, argv, "alpha-power", DEFAULT_ALPHA_POWER);
 
-                // carry out agent move
-                switch (agentMove) {
-                    
-                    // agent hit
-                    case HIT:
-                        
-                        // hit in game
-                        gameOver = game->hit();
-                        break;
+    // update target picked at runtime
+    string targetName = UPDATE_TARGET_NAMES[ONE_STEP_Q];
+    readOption(argc, argv, "update-target", targetName);
+    const int UPDATE_TARGET = findName(UPDATE_TARGET_NAMES, UPDATE_TARGET_COUNT, targetName);
+    const double LAMBDA = readNumberOption(argc, argv, "lambda", DEFAULT_LAMBDA);
 
-                    case SPLIT:
+    // replay memory
+    const int REPLAY_SIZE = readNumberOption(argc, argv, "replay-size", DEFAULT_REPLAY_SIZE);
+    const double REPLAY_RATIO = readNumberOption(argc, argv, "replay-ratio", DEFAULT_REPLAY_RATIO);
+    const int REPLAY_BATCH = readNumberOption(argc, argv, "replay-batch", DEFAULT_REPLAY_BATCH);
+    const double REPLAY_PRIORITY = readNumberOption(argc, argv, "replay-priority", DEFAULT_REPLAY_PRIORITY);
 
-                        // add split info to split list
-                        split = {
-                            game->getState().playerCards.at(0),
-                            game->getState().dealerShowing,
-                            game->getDealerSecondCard(),
-                            agent->getGameActions()
-                        };
-                        splits.push_back(split);
+    // progress line rate
+    const double PROGRESS_SECONDS = readNumberOption(argc, argv, "progress-seconds", DEFAULT_PROGRESS_SECONDS);
 
-                        // setup first half of game
-                        game->runSplit();
+    // games to train on, shorter runs are for profiling and timing builds
+    const int GAMES = readNumberOption(argc, argv, "games", GAME_COUNT);
 
-                        break;
+    // q table snapshots for learning curves, in Chart<id>_qlog.bin
+    const int Q_LOG_BATCHES = readNumberOption(argc, argv, "qlog-batches", DEFAULT_Q_LOG_BATCHES);
 
-                    // agent double 
-                    case DOUBLE:
+    // fail on allocations in the game loop
+    const bool ALLOC_GUARD = hasFlag(argc, argv, "alloc-guard");
 
-                        // double bet in game
-                        game->doubleBet();
+    // check schedule and target
+    if (ALPHA_SCHEDULE == -1) {
 
-                        // take hit
-                        gameOver = game->hit();
-                        break;
-
-                    // agent stand
-                    case STAND:
-                        break;
-
-                }
-
-            }
-
-            // player dealer turn if game isn't over
-            if (!gameOver) {
-
-                game->playDealer();
-
-            }
-
-            // set reward for game results
-            agent->endGame(game->getScore());
-
-            // reset game
-            game->reset();
-
-        }
-        //cout << "splits played" << endl;
-
-        // check if time to train
-        if (gameNum % TRAIN_EVERY == 0) {
-
-            // update q tables
-            agent->train();
-            cout << "Trained through games " << gameNum << endl << endl;
-
-
-        }
+        cout << "Unknown alpha schedule: " << scheduleName << endl;
+        return 1;
 
     }
+    if (UPDATE_TARGET == -1) {
 
-    cout << "Training complete." << endl << endl;
-
-    // release dealer and game
-    delete dealer;
-    delete game;
-
-
-    // build chart out of agent
-
-    // open chart
-    ofstream outfile(CHART_NAME);
-
-    // write top left corner
-    outfile << ",";
-
-    // write header
-    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
-
-        outfile << DEALER_HANDS[i] << ",";
+        cout << "Unknown update target: " << targetName << endl;
+        return 1;
 
     }
-    outfile << endl;
-
-    // max q index finders
-    int maxQ;
-
-    // iterate through possible hand combos
-    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
-
-        // print player hand
-        outfile << PLAYER_HANDS[i] << ",";
-
-        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
 
-            // check if can split
-            if (!handIdxCanSplit(i)) {
+    // replay draws whole minibatches, so the batch has to hold a game and the ratio can't be negative
+    if (REPLAY_SIZE > 0 && REPLAY_BATCH <= 0) {
 
-                // set split value to min if not possible
-                agent->getQTable()[i][j][SPLIT] = numeric_limits<double>::min();
+        cout << "--replay-batch has to be at least 1" << endl;
+        return 1;
 
-            }
-
-            // get highest q value index
-            maxQ = max_element(agent->getQTable()[i][j], agent->getQTable()[i][j] + ACTION_TYPE_COUNT) - agent->getQTable()[i][j];
-
-            // check for max double
-            if (maxQ == DOUBLE) {
-
-                // if stand is a higher second option than hit...
-                if (agent->getQTable()[i][j][STAND] > agent->getQTable()[i][j][HIT]) {
-
-                    outfile << ACTION_NAMES[DOUBLE_STAND] << ",";
-
-                }
-                else {
-
-                    outfile << ACTION_NAMES[DOUBLE_HIT] << ",";
-
-                }
-
-            }
-            // else add to chart
-            else {
-
-                // print action
-                outfile << ACTION_NAMES[maxQ] << ",";
-
-            }
+    }
+    if (REPLAY_RATIO < 0) {
 
-        }
+        cout << "--replay-ratio can't be negative" << endl;
+        return 1;
 
-        outfile << endl;
     }
-    outfile.close();
 
+    // the guard needs allocations counted, and exploring starts still build their hands on the heap
+    if (ALLOC_GUARD && !ALLOC_TRACKING_BUILT) {
 
-    // open chart that is usable
-    outfile.open(USABLE_CHART_NAME);
+        cout << "--alloc-guard needs a build with -DBJ_ALLOC_TRACKING=1" << endl;
+        return 1;
 
-    // write top left corner
-    outfile << ",";
-
-    // write header
-    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
+    }
+    if (ALLOC_GUARD && START_MODE != NATURAL_STARTS) {
 
-        outfile << DEALER_HANDS[i] << ",";
+        cout << "--alloc-guard only covers natural starts" << endl;
+        return 1;
 
     }
-    outfile << endl;
 
-    // iterate through possible hand combos
-    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+    // blackjack dealer
+    Dealer* dealer = new Dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS);
 
-        // print player hand
-        outfile << PLAYER_HANDS[i] << ",";
+    // blackjack game
+    Game* game = new Game(dealer, SCORES);
 
-        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+    // initialize q learning agent
+    BlackJackAgent* agent = new BlackJackAgent(EPSILON, GAMMA, ALPHA);
+    agent->setAlphaSchedule(static_cast<AlphaSchedule>(ALPHA_SCHEDULE), ALPHA_POWER);
+    agent->setUpdateTarget(static_cast<UpdateTarget>(UPDATE_TARGET), LAMBDA);
+    if (REPLAY_SIZE > 0) {
 
-            
-            // check if can split
-            if (!handIdxCanSplit(i)) {
+        agent->setReplay(REPLAY_SIZE, REPLAY_RATIO, REPLAY_BATCH, REPLAY_PRIORITY);
 
-                // set split value to min if not possible
-                agent->getQTable()[i][j][SPLIT] = numeric_limits<int>::min();
+    }
+    agent->reserveTraining(TRAIN_EVERY);
 
-            }
+    // exploring starts state picker
+    StartSampler* sampler = new StartSampler(time(0));
 
-            // get highest q value index
-            maxQ = max_element(agent->getQTable()[i][j], agent->getQTable()[i][j] + ACTION_TYPE_COUNT) - agent->getQTable()[i][j];
+    // alternate game paths as held for split
+    vector<SplitInfo> splits;
+    splits.reserve(MAX_PENDING_SPLITS);
 
-            // check for max double
-            if (maxQ == DOUBLE) {
+    // training batches run
+    int batches = 0;
 
-                // if stand is a higher second option than hit...
-                if (agent->getQTable()[i][j][STAND] > agent->getQTable()[i][j][HIT]) {
+    // snapshot log
+    QLogWriter* qLog = nullptr;
+    if (Q_LOG_BATCHES > 0) {
+        qLog = new QLogWriter("Chart" + CHART_ID + "_qlog.bin");
+    }
 
-                    outfile << DOUBLE_STAND << ",";
+    // progress goes through the logger so the training loop never waits on stdout
+    AsyncLogger* logger = new AsyncLogger(cout);
+    TrainingProgress progress(logger, GAMES, PROGRESS_SECONDS);
 
-                }
-                else {
+    // iterate through games
+    logger->log("Beginning training...");
+    for (int gameNum = 0; gameNum < GAMES; gameNum ++) {
 
-                    outfile << DOUBLE_HIT << ",";
+        // play game and its split branches
+        {
+            BJ_ALLOC_GUARD(ALLOC_GUARD && batches > ALLOC_GUARD_WARMUP_BATCHES);
+            playTrainingGame(game, agent, sampler, START_MODE, EXPLORING_STARTS_RATE, splits);
+        }
 
-                }
+        // check if time to train
+        if (gameNum % TRAIN_EVERY == 0) {
 
+            // update q tables
+            progress.startPhase(TRAINING_PHASE);
+            trainAgent(agent, sampler, START_MODE);
+            progress.startPhase(SIMULATION_PHASE);
+            batches ++;
+
+            // snapshot of the tables every few batches
+            if (qLog && batches % Q_LOG_BATCHES == 0) {
+                qLog->writeSnapshot(gameNum + 1, agent->getTrainingCountTotal(), agent->getQTable(), agent->getQTableCounts());
             }
-            // else add to chart
-            else {
 
-                // print action
-                outfile << maxQ << ",";
-
-            }
+            // progress line if it's been long enough
+            progress.update(gameNum + 1, agent->getTrainingCountTotal());
 
         }
 
-        outfile << endl;
     }
-    outfile.close();
+    progress.finish(GAMES, agent->getTrainingCountTotal());
 
+    // last snapshot is the final table
+    if (qLog) {
 
-    // print training counts
-    outfile.open(MAX_TRAINING_CHART_NAME);
-
-    // write top left corner
-    outfile << ",";
-
-    // write header
-    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
-
-        outfile << DEALER_HANDS[i] << ",";
+        qLog->writeSnapshot(GAMES, agent->getTrainingCountTotal(), agent->getQTable(), agent->getQTableCounts());
+        delete qLog;
 
     }
-    outfile << endl;
 
-    // iterate through possible hand combos
-    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+    // write the rest of the log before printing again
+    logger->log("Training complete.\n");
+    delete logger;
 
-        // print player hand
-        outfile << PLAYER_HANDS[i] << ",";
+    // release dealer, game and start picker
+    delete dealer;
+    delete game;
+    delete sampler;
 
-        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
 
-            // get highest q value index
-            maxQ = max_element(agent->getQTable()[i][j], agent->getQTable()[i][j] + ACTION_TYPE_COUNT) - agent->getQTable()[i][j];
+    // build chart out of agent
+    writeChartFiles(CHART_ID, agent->getQTable(), agent->getQTableCounts());
 
-            // print action
-            outfile << agent->getQTableCounts()[i][j][maxQ] << ",";
 
-        }
+    // print confidence intervals on the action gaps
+    ofstream outfile(CI_CHART_NAME);
+    outfile << fixed;
 
-        outfile << endl;
-    }
-    outfile.close();
-
-
-    // print q values
-    outfile.open(Q_CHART_NAME);
+    // gap between the two best actions and its interval
+    double gap;
+    double halfWidth;
 
     // write top left corner
     outfile << ",";
@@ -483,82 +306,18 @@ int main(int argc, char* argv[]) {
 
         for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
 
-            // print q values
-            outfile << "[" << setw(4) << fixed;
-
-            for (int k = 0; k < ACTION_TYPE_COUNT - 1; k ++) {
-
-                // print action if not numerical min
-                if (agent->getQTable()[i][j][k] == numeric_limits<int>::min()) {
+            // print gap with its interval bounds if known
+            if (agent->getActionGap(i, j, gap, halfWidth) && halfWidth != numeric_limits<double>::infinity()) {
 
-                    outfile << " _  ";
-
-                }
-                else {
-
-                    outfile << agent->getQTable()[i][j][k] << " ";
-
-                }
-
-            }
-
-            // print action if not numerical min
-            if (agent->getQTable()[i][j][ACTION_TYPE_COUNT - 1] == numeric_limits<int>::min()) {
-
-                outfile << " _ ";
+                outfile << "[" << gap << " " << gap - halfWidth << " " << gap + halfWidth << "],";
 
             }
             else {
 
-                outfile << agent->getQTable()[i][j][ACTION_TYPE_COUNT - 1];
-
-            }
-
-            outfile << "],";
-
-        }
-
-        outfile << endl;
-    }
-    outfile.close();
-
-
-    // print all training counts
-    outfile.open(TRAINING_CHART_NAME);
-
-    // write top left corner
-    outfile << ",";
-
-    // write header
-    for (int i = 0; i < DEALER_HAND_COUNT; i ++) {
-
-        outfile << DEALER_HANDS[i] << ",";
-
-    }
-    outfile << endl;
-
-    // iterate through possible hand combos
-    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
-
-        // print player hand
-        outfile << PLAYER_HANDS[i] << ",";
-
-        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
-
-            // print q values
-            outfile << "[";
-
-            for (int k = 0; k < ACTION_TYPE_COUNT - 1; k ++) {
-
-                // print action
-                outfile << agent->getQTableCounts()[i][j][k] << " ";
+                outfile << "[ _ ],";
 
             }
 
-            outfile << agent->getQTableCounts()[i][j][ACTION_TYPE_COUNT - 1];
-
-            outfile << "],";
-
         }
 
         outfile << endl;
@@ -578,8 +337,22 @@ int main(int argc, char* argv[]) {
     outfile << "\tx right shift: " << E_RIGHT_SHIFT << endl;
     outfile << "Gamma: " << GAMMA << endl;
     outfile << "Alpha: " << ALPHA << endl;
-    outfile << "Game count: " << GAME_COUNT << endl;
+    outfile << "Alpha schedule:" << endl;
+    outfile << "\ttype: " << ALPHA_SCHEDULE_NAMES[ALPHA_SCHEDULE] << endl;
+    outfile << "\tpower: " << ALPHA_POWER << endl;
+    outfile << "Update target:" << endl;
+    outfile << "\ttype: " << UPDATE_TARGET_NAMES[UPDATE_TARGET] << endl;
+    outfile << "\tlambda: " << LAMBDA << endl;
+    outfile << "Replay:" << endl;
+    outfile << "\tbuffer size: " << REPLAY_SIZE << " games" << endl;
+    outfile << "\treplay ratio: " << REPLAY_RATIO << endl;
+    outfile << "\tminibatch size: " << REPLAY_BATCH << endl;
+    outfile << "\tpriority exponent: " << REPLAY_PRIORITY << endl;
+    outfile << "Game count: " << GAMES << endl;
     outfile << "Training interval: " << TRAIN_EVERY << " games" << endl;
+    outfile << "Exploring starts:" << endl;
+    outfile << "\tmode: " << START_MODE_NAMES[START_MODE] << endl;
+    outfile << "\trate: " << EXPLORING_STARTS_RATE << endl;
     outfile << "Deck count: " << DECK_COUNT << endl;
     outfile << "Reshuffle interval: " << SHUFFLE_EVERY_N_DECKS << " decks" << endl;
     outfile << "Rewards:" << endl;
@@ -589,12 +362,40 @@ int main(int argc, char* argv[]) {
     outfile << "\tLoss: " << SCORES.loss << endl;
     outfile << "\tDouble loss: " << SCORES.doubleLoss << endl;
     outfile << "\tPush: " << SCORES.push << endl;
+    progress.writeSummary(outfile);
     
     outfile.close();
 
+    // add the run to the results store
+    if (!recordTrainingRun(PARAM_FILE_NAME, CHART_ID)) {
+        cout << "Couldn't add the run to " << RESULTS_STORE_PATH << endl;
+    }
+
+    // event counts and trace of the whole run
+    writeCounterFiles(CHART_ID);
+    BJ_TRACE_WRITE(CHART_ID + "_trace.json");
+
+    // allocations of the whole run
+    AllocSnapshot allocations = allocSnapshot();
+    if (ALLOC_TRACKING_BUILT) {
+
+        outfile.open(CHART_ID + "_alloc.txt");
+        writeAllocReport(outfile, allocations, GAMES, agent->getTrainingCountTotal(), batches);
+        outfile.close();
+
+    }
+
 
     // cleanup
     delete agent;
 
+    // guard caught the game loop allocating
+    if (ALLOC_GUARD && allocations.guarded > 0) {
+
+        cout << "Alloc guard failed: " << allocations.guarded << " allocations in training games" << endl;
+        return 1;
+
+    }
+
     return 0;
 }
@@ -9,23 +9,45 @@
 #include <fstream>
 #include <string>
 #include <cmath>
+#include <vector>
+#include <ctime>
+#include <climits>
+#include <sstream>
+#include <algorithm>
+#include <iomanip>
+#include <functional>
+#include <chrono>
+#include <cstring>
 #include "BlackJack.h"
 #include "BlackJackAgent.h"
+#include "ChartIO.h"
+#include "CompiledChart.h"
+#include "Eval.h"
+#include "Betting.h"
+#include "Counting.h"
+#include "Stats.h"
+#include "Parallel.h"
+#include "Counters.h"
+#include "Trace.h"
+#include "AllocTracker.h"
+#include "Options.h"
+#include "ResultsStore.h"
+#include "HandTrace.h"
+#include "GameCoroutine.h"
 
 // namespace
 using std::cout, std::endl;
 using std::string;
+using std::vector;
+using std::ofstream;
+using std::stringstream;
 using std::getline;
-using std::stoi;
-using std::ifstream, std::ofstream;
-using std::log;
-
-
-// logarithm function with custom base
-double logb(int base, double x) {
-
-    return log(x) / log(base);
-}
+using std::max, std::min, std::stable_sort;
+using std::setw, std::left, std::right;
+using std::function;
+using std::erfc, std::fabs, std::sqrt;
+using std::chrono::steady_clock, std::chrono::duration;
+using std::memcmp;
 
 // constants
 
@@ -35,6 +57,21 @@ const int ROUND_COUNT = 5000;
 // number of games per round
 const int GAME_COUNT = 1000;
 
+// rounds handed to a worker at a time
+// each chunk gets its own dealer seeded from the base seed and chunk number,
+// so results only depend on the seed and not on the thread count
+const int ROUNDS_PER_CHUNK = 50;
+
+// chunks played between confidence interval checks when stopping on a target
+// checks only happen between batches so the stopping point doesn't depend on threads either
+const int CHUNKS_PER_BATCH = 20;
+
+// split branches a chunk keeps room for, more than a hand can ever have waiting
+const int MAX_PENDING_SPLITS = 32;
+
+// hand limit when stopping on a confidence interval target
+const double DEFAULT_MAX_HANDS = 1e8;
+
 // starting balance for each round
 const double STARTING_BAL = 1000;
 
@@ -49,26 +86,10 @@ const int IMIN = 100;
 const int ISPEED = 10;
 // the size by which the betting intervals grow
 const int ISIZE = 10;
-// betting and saving interval function
-auto I = [](double x) -> int {
-    int floorLog = logb(ISPEED, x);
-    return (floorLog < IMIN) ? IMIN : floorLog;
-};
+// betting strategy of the main results, the interval strategy is in Betting.h
+// and any number of other strategies can be followed with --bets or --bet-grid
+const BettingStrategy BETTING = {CONSTANT_BETTING, P, M, IMIN, ISPEED, ISIZE};
 // betting function
-/*auto Bet = [](double bal) -> double {
-    // return no balance
-    if (bal < M)
-        return 0.0;
-    
-    // calc bet
-    int floorInterval = bal / I(bal);
-    double bet = (bal - I(bal) * floorInterval) * P;
-    // return zero bet if between intervals
-    if (bet <= M) 
-        return M;
-    // return bet
-    return bet;
-};*/
 auto Bet = [](double bal) -> double {
     return M;
 };
@@ -94,342 +115,621 @@ const Scoring PAYOUTS = {
 
 };
 
-// main
-int main(int argc, char* argv[]) {
+// histogram bins for round stats
+// balances and drawdowns are binned up to a few starting balances, ruin times over the games in a round
+const int HISTOGRAM_BINS = 500;
+const double BALANCE_HISTOGRAM_HIGH = 5 * STARTING_BAL;
+const double DRAWDOWN_HISTOGRAM_HIGH = 2 * STARTING_BAL;
 
-    // chart name
-    const string CHART_ID = argv[1];
-    const string CHART_PATH = "../charts/Chart" + CHART_ID + "/Chart" + CHART_ID + "_readable.csv";
+// quantiles written to the summary
+const double SUMMARY_QUANTILES[] = {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+const string SUMMARY_QUANTILE_NAMES[] = {"p01", "p05", "p25", "p50", "p75", "p95", "p99"};
+const int SUMMARY_QUANTILE_COUNT = 7;
 
-    // save info to this filename
-    // if eval ID was given
-    if (argc > 2) {
-        const string EVAL_ID = argv[2];
-        const string SAVE_PATH = "../charts/Chart" + CHART_ID + "/Eval" + CHART_ID + "_" + EVAL_ID + ".txt";
+// distribution of a betting strategy's rounds
+struct BankrollStats {
+
+    // final, highest and largest drop in balance per round
+    Histogram finalBalance;
+    Histogram peakBalance;
+    Histogram maxDrawdown;
+
+    // game the bankroll went broke on, only for broke rounds
+    Histogram ruinGame;
+    int brokeRounds;
+
+    // constructor
+    BankrollStats() {
+
+        this->finalBalance = Histogram(0, BALANCE_HISTOGRAM_HIGH, HISTOGRAM_BINS);
+        this->peakBalance = Histogram(0, BALANCE_HISTOGRAM_HIGH, HISTOGRAM_BINS);
+        this->maxDrawdown = Histogram(0, DRAWDOWN_HISTOGRAM_HIGH, HISTOGRAM_BINS);
+        this->ruinGame = Histogram(0, GAME_COUNT, HISTOGRAM_BINS);
+        this->brokeRounds = 0;
 
     }
-    else {
-        const string SAVE_PATH = "../charts/Chart" + CHART_ID + "/Eval" + CHART_ID + ".txt";
+
+    // add the round a track just finished
+    void addRound(const BankrollTracks& tracks, int k) {
+
+        this->finalBalance.add(tracks.getBalance(k));
+        this->peakBalance.add(tracks.getPeak(k));
+        this->maxDrawdown.add(tracks.getDrawdown(k));
+        if (tracks.isBroke(k)) {
+
+            this->ruinGame.add(tracks.getRuinGame(k));
+            this->brokeRounds ++;
+
+        }
+
     }
 
-    // announce
-    cout << "Evaluating chart..." << endl;
+    // add another set of rounds
+    void merge(const BankrollStats& other) {
 
-    // create dealer
-    Dealer* dealer = new Dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS);
+        this->finalBalance.merge(other.finalBalance);
+        this->peakBalance.merge(other.peakBalance);
+        this->maxDrawdown.merge(other.maxDrawdown);
+        this->ruinGame.merge(other.ruinGame);
+        this->brokeRounds += other.brokeRounds;
 
-    // create game
-    Game* game = new Game(dealer, PAYOUTS);
+    }
 
-    // chart
-    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+};
+
+// results of a chunk of rounds
+struct ChunkResult {
+
+    int rounds;
+
+    // round distributions for each betting strategy
+    vector<BankrollStats> bankrolls;
+
+    // balance change per hand in bets
+    RunningStats hands;
+
+    // balance change per hand in bets for each true count bucket at the start of the hand
+    vector<RunningStats> bucketHands;
 
-    // results
-    double sum = 0;
+    // bet units put down and won back over all hands
+    double unitsBet;
+    double unitsWon;
+
+};
+
+// plays one round of games from the starting balance
+// every hand is played once and paid out to each betting strategy's bankroll,
+// the round goes on until every strategy is broke or the games run out
+// the true count at the start of each hand picks the chart and bet units
+// adds each hand's balance change in bets to the chunk's hand stats
+// with the alloc guard on, any allocation while playing the hands is counted as a failure
+// with a trace, every hand's cards, chart cells and balance change are recorded to it
+void playRound(Dealer* dealer, Game* game, const CountStrategy& strategy, vector<SplitInfo>& splits, BankrollTracks& tracks, ChunkResult& result, bool allocGuard, ChunkTrace* trace) {
+
+    BJ_ALLOC_SCOPE(ALLOC_EVAL);
+
+    // set new balances
+    tracks.startRound(STARTING_BAL);
+
+    // reshuffle deck
+    dealer->reshuffle();
+    if (trace) {
+        trace->startRound(dealer);
+    }
 
-    // open file stream to populate chart
-    ifstream infile(CHART_PATH);
-    string readIn;
+    // start games
+    BJ_ALLOC_GUARD(allocGuard);
+    double change;
+    int bucket;
+    for (int gameNum = 0; gameNum < GAME_COUNT; gameNum ++) {
 
-    // game round variables
-    double bal;
+        // count bucket before the cards come out
+        bucket = countBucket(dealer->getTrueCount());
 
-    // read in header
-    getline(infile, readIn);
+        // break if all broke
+        if (!tracks.placeBets(gameNum, strategy.getUnits(bucket))) {
+            break;
+        }
 
-    // iterate through player hands
-    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+        // play the hand and any splits and pay every bankroll
+        if (trace) {
 
-        // read in row label
-        getline(infile, readIn, ',');
+            trace->startHand();
+            change = playChartHand(game, strategy.getChart(bucket), splits, trace->getVisited());
+            trace->endHand(change);
 
-        // read in all dealer hands except last
-        for (int j = 0; j < DEALER_HAND_COUNT - 1; j ++) {
+        }
+        else {
 
-            // put action in chart
-            getline(infile, readIn, ',');
-            chart[i][j] = stoi(readIn);
+            change = playChartHand(game, strategy.getChart(bucket), splits);
 
         }
+        tracks.settle(change);
 
-        // read in last \n delimited item
-        getline(infile, readIn);
-        chart[i][DEALER_HAND_COUNT - 1] = stoi(readIn);
+        // hand information
+        result.hands.add(change);
+        result.bucketHands[bucket].add(change);
+        result.unitsBet += strategy.getUnits(bucket);
+        result.unitsWon += strategy.getUnits(bucket) * change;
+
+    }
 
+    if (trace) {
+        trace->endRound(dealer);
     }
 
-    // game variables
-    bool gameOver;
-    double bet;
-    ActionType agentMove;
-    pair<int, int> stateCoords;
-    SplitInfo split;
+}
+
+// empty results of a chunk
+ChunkResult newChunkResult(const vector<BettingStrategy>& strategies) {
+
+    ChunkResult result;
+    result.rounds = 0;
+    result.bankrolls = vector<BankrollStats>(strategies.size());
+    result.bucketHands = vector<RunningStats>(COUNT_BUCKET_COUNT);
+    result.unitsBet = 0;
+    result.unitsWon = 0;
+
+    return result;
+
+}
+
+// plays a chunk of rounds on its own dealer and game, recording them to trace if it's set
+ChunkResult playChunk(int chunk, int roundLimit, unsigned int seed, const CountStrategy& strategy, const vector<BettingStrategy>& strategies, bool allocGuard, ChunkTrace* trace) {
+
+    ChunkResult result = newChunkResult(strategies);
+
+    // own dealer, game and bankrolls for the chunk
+    Dealer* dealer = new Dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, seed + chunk);
+    Game* game = new Game(dealer, PAYOUTS);
+    BankrollTracks tracks(strategies);
     vector<SplitInfo> splits;
-    vector<ActionType> possibleActions;
-    vector<double> actionRatings;
+    splits.reserve(MAX_PENDING_SPLITS);
 
     // iter through rounds
-    for (int round = 0; round < ROUND_COUNT; round ++) {
+    int lastRound = (chunk + 1) * ROUNDS_PER_CHUNK;
+    for (int round = chunk * ROUNDS_PER_CHUNK; round < roundLimit && round < lastRound; round ++) {
 
-        // set new balance
-        bal = STARTING_BAL;
+        playRound(dealer, game, strategy, splits, tracks, result, allocGuard, trace);
 
-        // reshuffle deck
-        dealer->reshuffle();
+        // round information
+        for (int k = 0; k < tracks.size(); k ++) {
 
-        // start games
-        for (int gameNum = 0; gameNum < GAME_COUNT; gameNum ++) {
+            result.bankrolls.at(k).addRound(tracks, k);
+
+        }
+        result.rounds ++;
+
+    }
+
+    // release memory
+    delete game;
+    delete dealer;
+
+    return result;
+
+}
+
+// plays a chunk of a hand trace's rounds again with another chart
+// hands that didn't read a changed cell keep their recorded balance change
+// sets outOfHands if a round went broke in the trace but not with the new chart,
+// since the trace has no hands past where it went broke
+ChunkResult replayChunk(int chunk, const HandTraceReader& reader, const CompiledChart& chart, const vector<bool>& changed, const vector<BettingStrategy>& strategies, long long& replayed, bool& outOfHands) {
+
+    BJ_ALLOC_SCOPE(ALLOC_EVAL);
+
+    ChunkResult result = newChunkResult(strategies);
+    replayed = 0;
+    outOfHands = false;
+
+    // dealer that only deals the cards it's loaded with
+    Dealer* dealer = new Dealer(DECK_COUNT, REPLAY_SHOE_DECKS);
+    Game* game = new Game(dealer, PAYOUTS);
+    BankrollTracks tracks(strategies);
+    vector<SplitInfo> splits;
+    splits.reserve(MAX_PENDING_SPLITS);
+    vector<double> changes;
+    changes.reserve(GAME_COUNT);
 
-            // break if broke
-            if (!CanBet(bal)) {
-                
-                bal = 0;
+    int lastRound = min((chunk + 1) * ROUNDS_PER_CHUNK, reader.getRoundCount());
+    for (int round = chunk * ROUNDS_PER_CHUNK; round < lastRound; round ++) {
+
+        reader.replayRound(round, chart, changed, game, dealer, splits, changes, replayed);
+
+        // pay the changes out to every bankroll like playRound does
+        tracks.startRound(STARTING_BAL);
+        int gameNum = 0;
+        for (; gameNum < static_cast<int>(changes.size()); gameNum ++) {
+
+            if (!tracks.placeBets(gameNum, 1)) {
                 break;
             }
+            tracks.settle(changes.at(gameNum));
+            result.hands.add(changes.at(gameNum));
+            result.unitsBet += 1;
+            result.unitsWon += changes.at(gameNum);
 
-            // take bet
-            bet = Bet(bal); 
-            bal -= bet;
+        }
+        if (gameNum < GAME_COUNT && gameNum == static_cast<int>(changes.size()) && tracks.placeBets(gameNum, 1)) {
+            outOfHands = true;
+        }
+
+        for (int k = 0; k < tracks.size(); k ++) {
+            result.bankrolls.at(k).addRound(tracks, k);
+        }
+        result.rounds ++;
 
-            // deal game
-            gameOver = game->dealHands();
+    }
 
-            // set default agent move for iteration
-            agentMove = HIT;
+    delete game;
+    delete dealer;
 
-            // while the game isn't over and player isn't done making moves
-            while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
+    return result;
 
-                // get player moves
-                stateCoords = getTableIndex(game->getState());
-                
-                // check if player has to stand on 21
-                if (game->getState().playerSum == 21) {
+}
 
-                    agentMove = STAND;
+// a chunk played as a lane of a hand scheduler, with its own dealer and game like playChunk
+struct ChunkLane {
 
-                }
-                // get chart option
-                else {
-                    
-                    // lookup on chart
-                    agentMove = static_cast<ActionType>(chart[stateCoords.first][stateCoords.second]);
+    Dealer* dealer;
+    Game* game;
+    BankrollTracks tracks;
+    vector<SplitInfo> splits;
 
-                    // check if can't double and it's a double hit
-                    if (agentMove == DOUBLE_HIT && game->getState().playerCards.size() != 2) {
-                        
-                        // set hit
-                        agentMove = HIT;
+    // round being played and the one after the chunk's last
+    int round;
+    int lastRound;
 
-                    }
-                    // check if can't double and it's a double stand
-                    else if (agentMove == DOUBLE_STAND && game->getState().playerCards.size() != 2) {
-                        
-                        // set hit
-                        agentMove = STAND;
+    // game of the round and true count bucket it started in
+    int gameNum;
+    int bucket;
+    bool inRound;
 
-                    }
-                    // else if still double
-                    else if (agentMove == DOUBLE_HIT || agentMove == DOUBLE_STAND) {
+};
 
-                        agentMove = DOUBLE;
+// plays chunks side by side on this thread as lanes of a hand scheduler
+// every lane deals from the dealer its chunk would have had, so each chunk's results are
+// the same as playChunk's, stored from results on in chunk order
+// adds the decisions answered and the batches they took to decisions and batches
+void playChunksInFlight(int firstChunk, int chunkCount, int roundLimit, unsigned int seed, const CountStrategy& strategy, const vector<BettingStrategy>& strategies, bool allocGuard, ChunkResult* results, long long& decisions, long long& batches) {
 
-                    }
+    BJ_ALLOC_SCOPE(ALLOC_EVAL);
 
-                }
-                
-                // carry out agent move
-                switch (agentMove) {
-                    
-                    // agent hit
-                    case HIT:
+    // a lane for each chunk
+    vector<ChunkLane> lanes;
+    lanes.reserve(chunkCount);
+    for (int c = 0; c < chunkCount; c ++) {
 
-                        // hit in game
-                        gameOver = game->hit();
-                        break;
+        int chunk = firstChunk + c;
+        results[c] = newChunkResult(strategies);
+        Dealer* dealer = new Dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, seed + chunk);
+        lanes.push_back({dealer, new Game(dealer, PAYOUTS), BankrollTracks(strategies), vector<SplitInfo>(), chunk * ROUNDS_PER_CHUNK, min((chunk + 1) * ROUNDS_PER_CHUNK, roundLimit), 0, 0, false});
+        lanes.back().splits.reserve(MAX_PENDING_SPLITS);
 
-                    case SPLIT:
+    }
 
-                        // add split info to split list to play other side of game
-                        split = {
-                            game->getState().playerCards.at(0),
-                            game->getState().dealerShowing,
-                            game->getDealerSecondCard()
-                        };
-                        splits.push_back(split);
+    // next hand of a lane's round the way playRound goes through them, starting rounds as they end
+    auto nextHand = [&](int lane, HandCoroutine& hand, const CompiledChart*& chart) -> bool {
 
-                        // setup this half of the game
-                        game->runSplit();
+        ChunkLane& chunkLane = lanes[lane];
+        ChunkResult& result = results[lane];
+        while (chunkLane.round < chunkLane.lastRound) {
 
-                        break;
+            // set new balances and reshuffle deck
+            if (!chunkLane.inRound) {
 
-                    // agent double 
-                    case DOUBLE:
+                chunkLane.tracks.startRound(STARTING_BAL);
+                chunkLane.dealer->reshuffle();
+                chunkLane.gameNum = 0;
+                chunkLane.inRound = true;
 
-                        // double bet in game
-                        game->doubleBet();
-                        bal -= bet;
+            }
 
-                        // take hit
-                        gameOver = game->hit();
-                        break;
+            // next game unless they're out or every bankroll is broke
+            if (chunkLane.gameNum < GAME_COUNT) {
 
-                    // agent stand
-                    case STAND:
+                chunkLane.bucket = countBucket(chunkLane.dealer->getTrueCount());
+                if (chunkLane.tracks.placeBets(chunkLane.gameNum, strategy.getUnits(chunkLane.bucket))) {
 
-                        break;
+                    chart = &strategy.getChart(chunkLane.bucket);
+                    hand = playHandCoroutine(chunkLane.game, chunkLane.splits);
+                    return true;
 
                 }
 
             }
 
-            // player dealer turn if game isn't over
-            if (!gameOver) {
+            // round information
+            for (int k = 0; k < chunkLane.tracks.size(); k ++) {
+                result.bankrolls.at(k).addRound(chunkLane.tracks, k);
+            }
+            result.rounds ++;
+            chunkLane.round ++;
+            chunkLane.inRound = false;
 
-                game->playDealer();
+        }
 
-            }
+        return false;
+
+    };
 
-            // update balance
-            bal += bet + game->getScore() * bet;
+    // pay every bankroll and add the hand information
+    auto finishHand = [&](int lane, double change) {
 
-            // reset game
-            game->reset();
-            
-            // run other branches of split game
-            while (splits.size() > 0) {
+        ChunkLane& chunkLane = lanes[lane];
+        ChunkResult& result = results[lane];
+        chunkLane.tracks.settle(change);
+        result.hands.add(change);
+        result.bucketHands[chunkLane.bucket].add(change);
+        result.unitsBet += strategy.getUnits(chunkLane.bucket);
+        result.unitsWon += strategy.getUnits(chunkLane.bucket) * change;
+        chunkLane.gameNum ++;
 
-                // play split game
+    };
 
-                // fetch split data
-                split = splits.back();
-                splits.pop_back();
+    // play every lane's rounds
+    HandScheduler scheduler(chunkCount);
+    {
 
-                // deal game
-                game->setupSplit(split.playerCard, split.dealerCard1, split.dealerCard2);
+        BJ_ALLOC_GUARD(allocGuard);
+        scheduler.run(nextHand, finishHand);
 
-                // deal player second card
-                game->hit();
+    }
+    decisions += scheduler.getDecisionCount();
+    batches += scheduler.getBatchCount();
 
-                // take bet
-                bal -= bet;
+    // release memory
+    for (ChunkLane& chunkLane : lanes) {
 
-                // set default agent move for iteration
-                agentMove = HIT;
+        delete chunkLane.game;
+        delete chunkLane.dealer;
 
-                // while the game isn't over and player isn't done making moves
-                while (!gameOver && (agentMove == HIT || agentMove == SPLIT)) {
+    }
 
-                    // get player moves
-                    stateCoords = getTableIndex(game->getState());
+}
 
-                    // check if player has to stand on 21
-                    if (game->getState().playerSum == 21) {
+// results of a chunk of paired rounds
+// differences against the first chart are kept at each chart's index, index 0 is unused
+struct PairedChunkResult {
 
-                        agentMove = STAND;
+    // final balances added up per chart
+    vector<double> balanceSums;
+    int rounds;
 
-                    }
-                    // get chart option
-                    else {
-                        
-                        // lookup on chart
-                        agentMove = static_cast<ActionType>(chart[stateCoords.first][stateCoords.second]);
+    // balance change per hand in bets for each chart
+    vector<RunningStats> hands;
 
-                        // check if can't double and it's a double hit
-                        if (agentMove == DOUBLE_HIT && game->getState().playerCards.size() != 2) {
-                            
-                            // set hit
-                            agentMove = HIT;
+    // final balance difference per round
+    vector<RunningStats> roundDiffs;
 
-                        }
-                        // check if can't double and it's a double stand
-                        else if (agentMove == DOUBLE_STAND && game->getState().playerCards.size() != 2) {
-                            
-                            // set hit
-                            agentMove = STAND;
+    // balance change difference per hand in bets
+    vector<RunningStats> handDiffs;
 
-                        }
-                        // else if still double
-                        else if (agentMove == DOUBLE_HIT || agentMove == DOUBLE_STAND) {
+    // difference in average balance change per hand over a round, chart j minus chart i,
+    // kept at i * chart count + j for i < j when recording every pair
+    vector<RunningStats> pairDiffs;
 
-                            agentMove = DOUBLE;
+};
 
-                        }
+// empty paired results for a number of charts
+PairedChunkResult newPairedResult(int chartCount, bool recordPairs) {
 
-                    }
+    PairedChunkResult result;
+    result.balanceSums = vector<double>(chartCount, 0);
+    result.rounds = 0;
+    result.hands = vector<RunningStats>(chartCount);
+    result.roundDiffs = vector<RunningStats>(chartCount);
+    result.handDiffs = vector<RunningStats>(chartCount);
+    result.pairDiffs = vector<RunningStats>(recordPairs ? chartCount * chartCount : 0);
 
-                    // carry out agent move
-                    switch (agentMove) {
-                        
-                        // agent hit
-                        case HIT:
-                            
-                            // hit in game
-                            gameOver = game->hit();
-                            break;
+    return result;
 
-                        case SPLIT:
+}
 
-                            // add split info to split list
-                            split = {
-                                game->getState().playerCards.at(0),
-                                game->getState().dealerShowing,
-                                game->getDealerSecondCard()
-                            };
-                            splits.push_back(split);
+// adds a chunk's paired results to the total
+void mergePairedResult(PairedChunkResult& total, const PairedChunkResult& chunk) {
 
-                            // setup first half of game
-                            game->runSplit();
+    total.rounds += chunk.rounds;
+    for (unsigned int c = 0; c < total.balanceSums.size(); c ++) {
 
-                            break;
+        total.balanceSums.at(c) += chunk.balanceSums.at(c);
+        total.hands.at(c).merge(chunk.hands.at(c));
+        total.roundDiffs.at(c).merge(chunk.roundDiffs.at(c));
+        total.handDiffs.at(c).merge(chunk.handDiffs.at(c));
 
-                        // agent double 
-                        case DOUBLE:
+    }
+    for (unsigned int p = 0; p < total.pairDiffs.size(); p ++) {
+        total.pairDiffs.at(p).merge(chunk.pairDiffs.at(p));
+    }
 
-                            // double bet in game
-                            game->doubleBet();
-                            bal -= bet;
+}
 
-                            // take hit
-                            gameOver = game->hit();
-                            break;
+// plays a chunk of rounds with every chart on the same cards
+// each hand starts every chart from a copy of the same shoe, charts that play
+// the hand differently go on with their own copy and the shoe moves on as the
+// first chart left it
+PairedChunkResult playPairedChunk(int chunk, int roundLimit, unsigned int seed, const vector<CompiledChart>& charts, bool recordPairs, bool allocGuard) {
+
+    const int CHART_COUNT = charts.size();
+    PairedChunkResult result = newPairedResult(CHART_COUNT, recordPairs);
+
+    // shared shoe and a dealer and game per chart
+    Dealer shoe(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, seed + chunk);
+    vector<Dealer> dealers(CHART_COUNT, shoe);
+    vector<Game*> games;
+    for (int c = 0; c < CHART_COUNT; c ++) {
+        games.push_back(new Game(&dealers.at(c), PAYOUTS));
+    }
+    vector<SplitInfo> splits;
+    splits.reserve(MAX_PENDING_SPLITS);
 
-                        // agent stand
-                        case STAND:
-                            break;
+    // round variables
+    vector<double> bals(CHART_COUNT);
+    vector<double> changes(CHART_COUNT);
+    vector<double> roundChanges(CHART_COUNT);
+    int roundHands;
+    bool broke;
 
-                    }
+    // iter through rounds
+    int lastRound = (chunk + 1) * ROUNDS_PER_CHUNK;
+    for (int round = chunk * ROUNDS_PER_CHUNK; round < roundLimit && round < lastRound; round ++) {
 
-                }
+        // set new balances
+        for (int c = 0; c < CHART_COUNT; c ++) {
+            bals.at(c) = STARTING_BAL;
+            roundChanges.at(c) = 0;
+        }
+        roundHands = 0;
 
-                // player dealer turn if game isn't over
-                if (!gameOver) {
+        // reshuffle deck
+        shoe.reshuffle();
+
+        // start games
+        BJ_ALLOC_GUARD(allocGuard);
+        for (int gameNum = 0; gameNum < GAME_COUNT; gameNum ++) {
 
-                    game->playDealer();
+            // hands stay paired only while every chart can bet,
+            // so the round ends for all of them once one is broke
+            broke = false;
+            for (int c = 0; c < CHART_COUNT; c ++) {
 
+                if (!CanBet(bals.at(c))) {
+                    bals.at(c) = 0;
+                    broke = true;
                 }
 
-                // update balance
-                bal += bet + game->getScore() * bet;
+            }
+            if (broke) {
+                break;
+            }
+
+            // play the hand with every chart from the same shoe
+            for (int c = 0; c < CHART_COUNT; c ++) {
+
+                dealers.at(c) = shoe;
+                changes.at(c) = playChartHand(games.at(c), charts.at(c), splits);
+                bals.at(c) += Bet(bals.at(c)) * changes.at(c);
 
-                // reset game
-                game->reset();
+                result.hands.at(c).add(changes.at(c));
+                roundChanges.at(c) += changes.at(c);
+
+            }
+            shoe = dealers.at(0);
+            roundHands ++;
 
+            // hand differences
+            for (int c = 1; c < CHART_COUNT; c ++) {
+                result.handDiffs.at(c).add(changes.at(c) - changes.at(0));
             }
 
         }
 
         // round information
-        sum += bal;
+        for (int c = 0; c < CHART_COUNT; c ++) {
+
+            result.balanceSums.at(c) += bals.at(c);
+            result.roundDiffs.at(c).add(bals.at(c) - bals.at(0));
+
+        }
+        result.rounds ++;
+
+        // differences between every pair of charts
+        if (recordPairs && roundHands > 0) {
+
+            for (int i = 0; i < CHART_COUNT; i ++) {
+                for (int j = i + 1; j < CHART_COUNT; j ++) {
+                    result.pairDiffs.at(i * CHART_COUNT + j).add((roundChanges.at(j) - roundChanges.at(i)) / roundHands);
+                }
+            }
+
+        }
 
     }
 
-    // save eval info to file
-    ofstream outfile(SAVE_PATH);
+    // release memory
+    for (int c = 0; c < CHART_COUNT; c ++) {
+        delete games.at(c);
+    }
 
-    // write out all eval params
-    outfile << "Evaluation for Chart" << CHART_ID << endl << endl;
-    outfile << "Gambling rounds: " << ROUND_COUNT << endl;
+    return result;
+
+}
+
+// eval settings from the command line
+struct EvalSettings {
+
+    // worker threads and base seed for the dealers
+    int threads;
+    unsigned int seed;
+
+    // stopping rule, a target of 0 plays the set round count
+    double ciTarget;
+    double maxHands;
+    bool sequential;
+    int roundLimit;
+
+    // count allocations while hands are played as failures
+    bool allocGuard;
+
+};
+
+// number of chunks to play in a batch
+int batchChunkCount(const EvalSettings& settings) {
+
+    return settings.sequential ? CHUNKS_PER_BATCH : (settings.roundLimit + ROUNDS_PER_CHUNK - 1) / ROUNDS_PER_CHUNK;
+
+}
+
+// plays paired batches of chunks until the set rounds are done or the stopping rule is met
+// the stopping rule is checked between batches on the half width given for the results so far
+PairedChunkResult playPairedBatches(const vector<CompiledChart>& charts, const EvalSettings& settings, bool recordPairs, const function<double(const PairedChunkResult&)>& halfWidth, bool& targetMet) {
+
+    // results added in chunk order
+    PairedChunkResult total = newPairedResult(charts.size(), recordPairs);
+    targetMet = false;
+
+    int firstChunk = 0;
+    while (true) {
+
+        BJ_TRACE_ZONE_ARG("batch", firstChunk / CHUNKS_PER_BATCH);
+
+        // play chunks of rounds on the workers
+        int chunkCount = batchChunkCount(settings);
+        vector<PairedChunkResult> chunkResults(chunkCount);
+        runChunks(chunkCount, settings.threads, [&](int chunk, int worker) {
+            chunkResults.at(chunk) = playPairedChunk(firstChunk + chunk, settings.roundLimit, settings.seed, charts, recordPairs, settings.allocGuard);
+        });
+
+        // combine in chunk order
+        BJ_TRACE_ZONE("merge");
+        for (int chunk = 0; chunk < chunkCount; chunk ++) {
+            mergePairedResult(total, chunkResults.at(chunk));
+        }
+        firstChunk += chunkCount;
+
+        // set round count done
+        if (!settings.sequential) {
+            break;
+        }
+
+        // check stopping rule
+        double width = halfWidth(total);
+        cout << "\t" << total.hands.at(0).getCount() << " hands, widest CI +/- " << width * 100 << "%" << endl;
+        targetMet = width <= settings.ciTarget;
+        if (targetMet || total.hands.at(0).getCount() >= settings.maxHands) {
+            break;
+        }
+
+    }
+
+    return total;
+
+}
+
+// writes the eval settings shared by every eval file
+void writeEvalSettings(ofstream& outfile, int rounds, const EvalSettings& settings, bool targetMet) {
+
+    outfile << "Gambling rounds: " << rounds << endl;
     outfile << "Games per round: " <<  GAME_COUNT << endl;
     outfile << "Round starting balance: $" << STARTING_BAL << endl;
     outfile << "Bet per game: $ const betting strat" << endl;
@@ -438,15 +738,751 @@ int main(int argc, char* argv[]) {
 
     outfile << "Deck count: " << DECK_COUNT << endl;
     outfile << "Decks dealt before reshuffle: " << SHUFFLE_EVERY_N_DECKS << endl;
+    outfile << "Seed: " << settings.seed << endl;
+    if (settings.sequential) {
+        outfile << "Stopping rule: 95% CI half width <= " << settings.ciTarget * 100 << "% or " << settings.maxHands << " hands (" << (targetMet ? "target met" : "hand limit reached") << ")" << endl;
+    }
+
+}
+
+// writes a mean with its standard error and 95% CI
+void writeInterval(ofstream& outfile, const string& label, const RunningStats& stats, double scale, const string& unit) {
+
+    double mean = stats.getMean() * scale;
+    double halfWidth = CI_Z * stats.getStandardError() * scale;
+    outfile << "\t" << label << ": " << mean << unit << " +/- " << halfWidth << unit;
+    outfile << " (SE " << stats.getStandardError() * scale << unit << ", 95% CI [" << mean - halfWidth << unit << ", " << mean + halfWidth << unit << "])" << endl;
+
+}
+
+// two sided p value of a mean difference being zero
+double differencePValue(const RunningStats& diff) {
+
+    if (diff.getStandardError() == 0) {
+        return (diff.getMean() == 0) ? 1 : 0;
+    }
+
+    return erfc(fabs(diff.getMean() / diff.getStandardError()) / sqrt(2.0));
+
+}
+
+// writes allocation counts by subsystem next to the results in a tracking build
+// returns the exit code, 1 if the alloc guard caught an allocation while hands were played
+int finishAllocReport(const string& basePath, long long hands, const EvalSettings& settings) {
+
+    if (!ALLOC_TRACKING_BUILT) {
+        return 0;
+    }
+
+    AllocSnapshot snapshot = allocSnapshot();
+    ofstream outfile(basePath + "_alloc.txt");
+    writeAllocReport(outfile, snapshot, hands, 0, 0);
+
+    if (settings.allocGuard && snapshot.guarded > 0) {
+
+        cout << "Alloc guard failed: " << snapshot.guarded << " allocations while hands were played" << endl;
+        return 1;
+
+    }
+
+    return 0;
+
+}
+
+// loads charts by id, false if one can't be loaded
+bool loadCharts(const vector<string>& chartIds, vector<CompiledChart>& charts) {
+
+    string error;
+    charts = vector<CompiledChart>(chartIds.size());
+    for (unsigned int c = 0; c < chartIds.size(); c ++) {
+
+        if (!loadChartById(chartIds.at(c), charts.at(c), error)) {
+
+            cout << "Can't load Chart" << chartIds.at(c) << ": " << error << endl;
+            return false;
+
+        }
+
+    }
+
+    return true;
+
+}
+
+// plays charts on the same shoes and compares each to the first
+int runPaired(const vector<string>& chartIds, const EvalSettings& settings) {
+
+    const int CHART_COUNT = chartIds.size();
+
+    // charts
+    vector<CompiledChart> charts;
+    if (!loadCharts(chartIds, charts)) {
+        return 1;
+    }
+
+    // announce
+    cout << "Evaluating " << CHART_COUNT << " charts paired with " << settings.threads << " threads..." << endl;
+
+    // stop on the widest difference interval
+    bool targetMet;
+    PairedChunkResult result = playPairedBatches(charts, settings, false, [](const PairedChunkResult& total) -> double {
+
+        double halfWidth = 0;
+        for (unsigned int c = 1; c < total.handDiffs.size(); c ++) {
+            halfWidth = max(halfWidth, CI_Z * total.handDiffs.at(c).getStandardError());
+        }
+        return halfWidth;
+
+    }, targetMet);
+
+    // save eval info to file next to the first chart
+    string SAVE_PATH = "../charts/Chart" + chartIds.at(0) + "/Paired" + chartIds.at(0);
+    for (int c = 1; c < CHART_COUNT; c ++) {
+        SAVE_PATH += "_vs_" + chartIds.at(c);
+    }
+    SAVE_PATH += ".txt";
+    ofstream outfile(SAVE_PATH);
+
+    // write out all eval params
+    outfile << "Paired evaluation for Charts";
+    for (int c = 0; c < CHART_COUNT; c ++) {
+        outfile << " " << chartIds.at(c);
+    }
+    outfile << endl << "Every chart plays the same shoe, differences are against Chart" << chartIds.at(0) << endl << endl;
+    writeEvalSettings(outfile, result.rounds, settings, targetMet);
     outfile << "Results:" << endl;
-    outfile << "\tAverage final balance: $" << sum / ROUND_COUNT << endl;
-    outfile << "\tAverage balance increase: $" << ((sum / ROUND_COUNT) - STARTING_BAL) << " | " << ((sum / ROUND_COUNT) - STARTING_BAL) / STARTING_BAL * 100 << "%" << endl;
+    for (int c = 0; c < CHART_COUNT; c ++) {
+        outfile << "\tChart" << chartIds.at(c) << " average final balance: $" << result.balanceSums.at(c) / result.rounds << endl;
+    }
+    for (int c = 1; c < CHART_COUNT; c ++) {
 
-    // release memory
-    delete dealer;
-    delete game;
+        outfile << "Chart" << chartIds.at(c) << " - Chart" << chartIds.at(0) << ":" << endl;
+        writeInterval(outfile, "Final balance difference per round ($)", result.roundDiffs.at(c), 1, "");
+        writeInterval(outfile, "Edge difference per hand", result.handDiffs.at(c), 100, "%");
 
+    }
+
+    // event counts and trace of every chart's hands
+    writeCounterFiles(SAVE_PATH.substr(0, SAVE_PATH.size() - 4));
+    BJ_TRACE_WRITE(SAVE_PATH.substr(0, SAVE_PATH.size() - 4) + "_trace.json");
+
+    cout << "Results saved to " << SAVE_PATH << endl;
     cout << "Evaluation complete." << endl;
 
-    return 0;
+    return finishAllocReport(SAVE_PATH.substr(0, SAVE_PATH.size() - 4), result.hands.at(0).getCount() * CHART_COUNT, settings);
+
+}
+
+// plays every chart in the charts folder on the same shoes and ranks them
+// pairwise significance uses the per round paired differences in edge per hand
+int runTournament(const EvalSettings& settings) {
+
+    // every chart with a readable csv
+    const vector<string> chartIds = findChartIds("../charts");
+    const int CHART_COUNT = chartIds.size();
+    if (CHART_COUNT < 2) {
+
+        cout << "Tournament needs at least two charts" << endl;
+        return 1;
+
+    }
+
+    // charts
+    vector<CompiledChart> charts;
+    if (!loadCharts(chartIds, charts)) {
+        return 1;
+    }
+
+    // announce
+    cout << "Tournament of " << CHART_COUNT << " charts with " << settings.threads << " threads..." << endl;
+
+    // stop on the widest chart edge interval
+    bool targetMet;
+    PairedChunkResult result = playPairedBatches(charts, settings, true, [](const PairedChunkResult& total) -> double {
+
+        double halfWidth = 0;
+        for (unsigned int c = 0; c < total.hands.size(); c ++) {
+            halfWidth = max(halfWidth, CI_Z * total.hands.at(c).getStandardError());
+        }
+        return halfWidth;
+
+    }, targetMet);
+
+    // rank by edge per hand
+    vector<int> ranking(CHART_COUNT);
+    for (int c = 0; c < CHART_COUNT; c ++) {
+        ranking.at(c) = c;
+    }
+    stable_sort(ranking.begin(), ranking.end(), [&](int a, int b) -> bool {
+        return result.hands.at(a).getMean() > result.hands.at(b).getMean();
+    });
+
+    // p value of the paired difference between two charts
+    auto pairPValue = [&](int a, int b) -> double {
+        return differencePValue(result.pairDiffs.at(min(a, b) * CHART_COUNT + max(a, b)));
+    };
+
+    // save leaderboard
+    const string SAVE_PATH = "../charts/Tournament.txt";
+    const string PAIRWISE_PATH = "../charts/Tournament_pairwise.csv";
+    ofstream outfile(SAVE_PATH);
+
+    outfile << "Tournament of " << CHART_COUNT << " charts" << endl;
+    outfile << "Every chart plays the same shoes, p values are two sided paired z tests on edge per hand by round" << endl << endl;
+    writeEvalSettings(outfile, result.rounds, settings, targetMet);
+    outfile << "Hands played per chart: " << result.hands.at(0).getCount() << endl;
+    outfile << "Leaderboard:" << endl;
+    outfile << left << setw(6) << "rank" << setw(16) << "chart" << right << setw(12) << "edge %" << setw(12) << "+/- 95%" << setw(14) << "avg balance" << setw(14) << "p vs next" << setw(10) << "beats" << endl;
+    for (int r = 0; r < CHART_COUNT; r ++) {
+
+        int c = ranking.at(r);
+
+        // charts below this one it's significantly better than
+        int beats = 0;
+        for (int below = r + 1; below < CHART_COUNT; below ++) {
+            if (pairPValue(c, ranking.at(below)) < 0.05) {
+                beats ++;
+            }
+        }
+
+        outfile << left << setw(6) << r + 1 << setw(16) << "Chart" + chartIds.at(c) << right;
+        outfile << setw(12) << result.hands.at(c).getMean() * 100 << setw(12) << CI_Z * result.hands.at(c).getStandardError() * 100;
+        outfile << setw(14) << result.balanceSums.at(c) / result.rounds;
+        if (r + 1 < CHART_COUNT) {
+            outfile << setw(14) << pairPValue(c, ranking.at(r + 1));
+        }
+        else {
+            outfile << setw(14) << "-";
+        }
+        outfile << setw(10) << beats << endl;
+
+    }
+
+    // save every pair's p value in leaderboard order
+    ofstream pairfile(PAIRWISE_PATH);
+    pairfile << "chart";
+    for (int r = 0; r < CHART_COUNT; r ++) {
+        pairfile << "," << chartIds.at(ranking.at(r));
+    }
+    pairfile << endl;
+    for (int r1 = 0; r1 < CHART_COUNT; r1 ++) {
+
+        pairfile << chartIds.at(ranking.at(r1));
+        for (int r2 = 0; r2 < CHART_COUNT; r2 ++) {
+            pairfile << ",";
+            if (r1 != r2) {
+                pairfile << pairPValue(ranking.at(r1), ranking.at(r2));
+            }
+        }
+        pairfile << endl;
+
+    }
+
+    // event counts and trace of every chart's hands
+    writeCounterFiles(SAVE_PATH.substr(0, SAVE_PATH.size() - 4));
+    BJ_TRACE_WRITE(SAVE_PATH.substr(0, SAVE_PATH.size() - 4) + "_trace.json");
+
+    cout << "Leaderboard saved to " << SAVE_PATH << " and " << PAIRWISE_PATH << endl;
+    cout << "Evaluation complete." << endl;
+
+    return finishAllocReport(SAVE_PATH.substr(0, SAVE_PATH.size() - 4), result.hands.at(0).getCount() * CHART_COUNT, settings);
+
+}
+
+// writes a histogram's stats and quantiles as a json object member
+void writeJsonDistribution(ofstream& outfile, const string& name, const Histogram& histogram, bool more) {
+
+    outfile << "      \"" << name << "\": {\"count\": " << histogram.getStats().getCount();
+    if (histogram.getStats().getCount() > 0) {
+
+        outfile << ", \"mean\": " << histogram.getStats().getMean();
+        outfile << ", \"sd\": " << sqrt(histogram.getStats().getVariance());
+        outfile << ", \"min\": " << histogram.getMin();
+        for (int q = 0; q < SUMMARY_QUANTILE_COUNT; q ++) {
+            outfile << ", \"" << SUMMARY_QUANTILE_NAMES[q] << "\": " << histogram.getQuantile(SUMMARY_QUANTILES[q]);
+        }
+        outfile << ", \"max\": " << histogram.getMax();
+
+    }
+    outfile << "}" << (more ? "," : "") << endl;
+
+}
+
+// path of the hand trace an eval recorded, from <chart id> or <chart id>:<eval id>
+string handTracePath(const string& spec) {
+
+    size_t colon = spec.find(':');
+    string chartId = spec.substr(0, colon);
+    string evalId = (colon == string::npos) ? "" : "_" + spec.substr(colon + 1);
+
+    return "../charts/Chart" + chartId + "/Eval" + chartId + evalId + "_hands.bin";
+
+}
+
+// main
+// usage: eval.exe <chart id> [eval id] [options]
+//        eval.exe --paired <chart id>,<chart id>[,...] [options]
+//        eval.exe --tournament [options]
+// options: [--threads n] [--seed s] [--rounds n] [--ci-target percent] [--max-hands n] [--alloc-guard]
+// single chart options: [--bets const:M;interval:P:M:IMIN:ISPEED:ISIZE;...] [--bet-grid]
+//                       [--count-charts count:id,...] [--deviations index_plays.csv] [--bet-ramp count:units,...] [--count-stats]
+//                       [--record-hands] [--reuse-hands <chart id>[:<eval id>]] [--in-flight n]
+// with a ci target, rounds are played until the 95% ci half width of the edge per hand
+// (of every paired edge difference, or of every chart in a tournament) is at most the
+// target (in percent of a bet) or the hand limit is passed
+// --alloc-guard needs a -DBJ_ALLOC_TRACKING=1 build and fails the eval if playing hands allocates
+// --record-hands writes every hand's cards and chart cells next to the eval file, and
+// --reuse-hands evaluates this chart on that eval's hands, only playing again the hands that
+// read a cell this chart changed, each from the cards it started on
+// --in-flight has each worker play n chunks side by side as hand coroutines, answering the
+// decisions of every waiting hand in a batch, with the same results as playing them in turn
+int main(int argc, char* argv[]) {
+
+    // settings shared by every mode
+    EvalSettings settings;
+    settings.threads = readNumberOption(argc, argv, "threads", defaultThreadCount());
+    settings.seed = readNumberOption(argc, argv, "seed", time(0));
+    settings.ciTarget = readNumberOption(argc, argv, "ci-target", 0) / 100;
+    settings.maxHands = readNumberOption(argc, argv, "max-hands", DEFAULT_MAX_HANDS);
+    settings.sequential = settings.ciTarget > 0;
+    settings.roundLimit = settings.sequential ? INT_MAX : readNumberOption(argc, argv, "rounds", ROUND_COUNT);
+    settings.allocGuard = hasFlag(argc, argv, "alloc-guard");
+
+    // the guard needs allocations counted
+    if (settings.allocGuard && !ALLOC_TRACKING_BUILT) {
+
+        cout << "--alloc-guard needs a build with -DBJ_ALLOC_TRACKING=1" << endl;
+        return 1;
+
+    }
+
+    // every chart
+    if (hasFlag(argc, argv, "tournament")) {
+        return runTournament(settings);
+    }
+
+    // paired charts
+    string pairedList;
+    if (readOption(argc, argv, "paired", pairedList)) {
+
+        // split chart ids
+        vector<string> chartIds;
+        stringstream idStream(pairedList);
+        string chartId;
+        while (getline(idStream, chartId, ',')) {
+            chartIds.push_back(chartId);
+        }
+        if (chartIds.size() < 2) {
+
+            cout << "Paired mode needs at least two chart ids" << endl;
+            return 1;
+
+        }
+
+        return runPaired(chartIds, settings);
+
+    }
+
+    // chart name
+    const string CHART_ID = argv[1];
+
+    // save info to this filename
+    // eval ID is the second argument if it isn't an option
+    string SAVE_PATH = "../charts/Chart" + CHART_ID + "/Eval" + CHART_ID + ".txt";
+    string evalId;
+    if (argc > 2 && string(argv[2]).compare(0, 2, "--") != 0) {
+        evalId = argv[2];
+        SAVE_PATH = "../charts/Chart" + CHART_ID + "/Eval" + CHART_ID + "_" + evalId + ".txt";
+    }
+
+    // announce
+    cout << "Evaluating chart with " << settings.threads << " threads..." << endl;
+
+    // chart
+    CompiledChart chart;
+    string error;
+    if (!loadChartById(CHART_ID, chart, error)) {
+
+        cout << "Can't load Chart" << CHART_ID << ": " << error << endl;
+        return 1;
+
+    }
+
+    // betting strategies, the eval's own comes first
+    vector<BettingStrategy> strategies = {BETTING};
+    string betSpecs;
+    if (readOption(argc, argv, "bets", betSpecs) && !parseBettingStrategies(betSpecs, strategies)) {
+
+        cout << "Can't read betting strategies: " << betSpecs << endl;
+        return 1;
+
+    }
+    if (hasFlag(argc, argv, "bet-grid")) {
+
+        vector<BettingStrategy> grid = bettingGrid();
+        strategies.insert(strategies.end(), grid.begin(), grid.end());
+
+    }
+    const int STRATEGY_COUNT = strategies.size();
+
+    // charts and bet units by true count
+    CountStrategy countStrategy(chart);
+    string countCharts;
+    if (readOption(argc, argv, "count-charts", countCharts)) {
+
+        stringstream countStream(countCharts);
+        string step;
+        while (getline(countStream, step, ',')) {
+
+            size_t colon = step.find(':');
+            CompiledChart countChart;
+            if (colon == string::npos || !loadChartById(step.substr(colon + 1), countChart, error)) {
+
+                cout << "Can't read count chart " << step << ": " << error << endl;
+                return 1;
+
+            }
+            countStrategy.setChartFrom(atoi(step.substr(0, colon).c_str()), countChart);
+
+        }
+
+    }
+    string deviationsPath;
+    if (readOption(argc, argv, "deviations", deviationsPath) && !countStrategy.addDeviations(deviationsPath, error)) {
+
+        cout << "Can't read deviations: " << error << endl;
+        return 1;
+
+    }
+    string betRamp;
+    if (readOption(argc, argv, "bet-ramp", betRamp) && !countStrategy.setBetRamp(betRamp)) {
+
+        cout << "Can't read bet ramp: " << betRamp << endl;
+        return 1;
+
+    }
+    const bool COUNTING = !countCharts.empty() || !deviationsPath.empty() || !betRamp.empty() || hasFlag(argc, argv, "count-stats");
+
+    // hand traces, recorded next to the eval file or replayed from another eval's
+    const bool RECORD_HANDS = hasFlag(argc, argv, "record-hands");
+    const string HANDS_PATH = SAVE_PATH.substr(0, SAVE_PATH.size() - 4) + "_hands.bin";
+    string reuseSpec;
+    const bool REUSE_HANDS = readOption(argc, argv, "reuse-hands", reuseSpec);
+    if ((RECORD_HANDS || REUSE_HANDS) && (COUNTING || settings.allocGuard)) {
+
+        cout << "Hand traces can't be recorded or reused with count play or the alloc guard" << endl;
+        return 1;
+
+    }
+    // chunks each worker keeps in flight on a hand scheduler, 0 plays them one at a time
+    const int IN_FLIGHT = readNumberOption(argc, argv, "in-flight", 0);
+    if (IN_FLIGHT > 0 && (RECORD_HANDS || REUSE_HANDS)) {
+
+        cout << "Hand traces are played a chunk at a time and can't be used with --in-flight" << endl;
+        return 1;
+
+    }
+    if (REUSE_HANDS && settings.sequential) {
+
+        cout << "--reuse-hands plays the trace's rounds and can't stop on a ci target" << endl;
+        return 1;
+
+    }
+
+    // trace to reuse and the cells this chart changes from the one it was played with
+    HandTraceReader reader;
+    vector<bool> changedCells(COMPILED_CHART_SIZE, false);
+    int changedCount = 0;
+    if (REUSE_HANDS) {
+
+        if (!reader.open(handTracePath(reuseSpec), error)) {
+
+            cout << "Can't reuse hands: " << error << endl;
+            return 1;
+
+        }
+
+        const HandTraceHeader& header = reader.getHeader();
+        if (header.gamesPerRound != GAME_COUNT || header.deckCount != DECK_COUNT || header.shuffleEveryNDecks != SHUFFLE_EVERY_N_DECKS
+            || header.startingBalance != STARTING_BAL || memcmp(&header.payouts, &PAYOUTS, sizeof(Scoring)) != 0) {
+
+            cout << "Can't reuse hands: the trace was played with different game settings" << endl;
+            return 1;
+
+        }
+
+        for (int c = 0; c < COMPILED_CHART_SIZE; c ++) {
+
+            changedCells.at(c) = header.chart[c] != chart.cells[c];
+            changedCount += changedCells.at(c);
+
+        }
+        settings.seed = header.seed;
+
+    }
+
+    // results added in chunk order
+    int rounds = 0;
+    vector<BankrollStats> bankrolls(STRATEGY_COUNT);
+    RunningStats handStats;
+    vector<RunningStats> bucketHands(COUNT_BUCKET_COUNT);
+    double unitsBet = 0;
+    double unitsWon = 0;
+    bool targetMet = false;
+    auto mergeChunk = [&](const ChunkResult& chunkResult) {
+
+        rounds += chunkResult.rounds;
+        handStats.merge(chunkResult.hands);
+        for (int b = 0; b < COUNT_BUCKET_COUNT; b ++) {
+            bucketHands.at(b).merge(chunkResult.bucketHands.at(b));
+        }
+        unitsBet += chunkResult.unitsBet;
+        unitsWon += chunkResult.unitsWon;
+        for (int k = 0; k < STRATEGY_COUNT; k ++) {
+            bankrolls.at(k).merge(chunkResult.bankrolls.at(k));
+        }
+
+    };
+
+    // traces of every chunk in chunk order when recording
+    vector<ChunkTrace> chunkTraces;
+    long long replayedHands = 0;
+
+    // decisions the hand schedulers answered and the batches they took
+    long long schedulerDecisions = 0;
+    long long schedulerBatches = 0;
+
+    // play batches of chunks until the set rounds are done or the stopping rule is met
+    steady_clock::time_point start = steady_clock::now();
+    int firstChunk = 0;
+    while (!REUSE_HANDS) {
+
+        BJ_TRACE_ZONE_ARG("batch", firstChunk / CHUNKS_PER_BATCH);
+
+        // play chunks of rounds on the workers
+        int chunkCount = batchChunkCount(settings);
+        vector<ChunkResult> chunkResults(chunkCount);
+        chunkTraces.resize(RECORD_HANDS ? firstChunk + chunkCount : 0);
+        if (IN_FLIGHT > 0) {
+
+            // groups of chunks side by side on each worker
+            int groupCount = (chunkCount + IN_FLIGHT - 1) / IN_FLIGHT;
+            vector<long long> groupDecisions(groupCount, 0);
+            vector<long long> groupBatches(groupCount, 0);
+            runChunks(groupCount, settings.threads, [&](int group, int worker) {
+
+                int first = group * IN_FLIGHT;
+                playChunksInFlight(firstChunk + first, min(IN_FLIGHT, chunkCount - first), settings.roundLimit, settings.seed, countStrategy, strategies,
+                                   settings.allocGuard, &chunkResults.at(first), groupDecisions.at(group), groupBatches.at(group));
+
+            });
+            for (int group = 0; group < groupCount; group ++) {
+
+                schedulerDecisions += groupDecisions.at(group);
+                schedulerBatches += groupBatches.at(group);
+
+            }
+
+        }
+        else {
+
+            runChunks(chunkCount, settings.threads, [&](int chunk, int worker) {
+                ChunkTrace* trace = RECORD_HANDS ? &chunkTraces.at(firstChunk + chunk) : nullptr;
+                chunkResults.at(chunk) = playChunk(firstChunk + chunk, settings.roundLimit, settings.seed, countStrategy, strategies, settings.allocGuard, trace);
+            });
+
+        }
+
+        // combine in chunk order
+        BJ_TRACE_ZONE("merge");
+        for (int chunk = 0; chunk < chunkCount; chunk ++) {
+            mergeChunk(chunkResults.at(chunk));
+        }
+        firstChunk += chunkCount;
+
+        // set round count done
+        if (!settings.sequential) {
+            break;
+        }
+
+        // check stopping rule
+        double halfWidth = CI_Z * handStats.getStandardError();
+        cout << "\t" << handStats.getCount() << " hands, edge " << handStats.getMean() * 100 << "% +/- " << halfWidth * 100 << "%" << endl;
+        targetMet = halfWidth <= settings.ciTarget;
+        if (targetMet || handStats.getCount() >= settings.maxHands) {
+            break;
+        }
+
+    }
+
+    // the trace's rounds again, only playing hands that read a changed cell
+    if (REUSE_HANDS) {
+
+        int chunkCount = (reader.getRoundCount() + ROUNDS_PER_CHUNK - 1) / ROUNDS_PER_CHUNK;
+        vector<ChunkResult> chunkResults(chunkCount);
+        vector<long long> chunkReplayed(chunkCount, 0);
+        vector<char> chunkOutOfHands(chunkCount, false);
+        runChunks(chunkCount, settings.threads, [&](int chunk, int worker) {
+
+            bool outOfHands;
+            chunkResults.at(chunk) = replayChunk(chunk, reader, chart, changedCells, strategies, chunkReplayed.at(chunk), outOfHands);
+            chunkOutOfHands.at(chunk) = outOfHands;
+
+        });
+
+        for (int chunk = 0; chunk < chunkCount; chunk ++) {
+
+            if (chunkOutOfHands.at(chunk)) {
+
+                cout << "Can't reuse hands: a round the trace went broke in lasts longer with this chart, run a full eval" << endl;
+                return 1;
+
+            }
+            mergeChunk(chunkResults.at(chunk));
+            replayedHands += chunkReplayed.at(chunk);
+
+        }
+        cout << "Played " << replayedHands << " of " << handStats.getCount() << " hands again for " << changedCount << " changed cells" << endl;
+
+    }
+
+    // time spent playing, for throughput
+    const double PLAY_SECONDS = duration<double>(steady_clock::now() - start).count();
+    if (schedulerBatches > 0) {
+        cout << "Answered " << schedulerDecisions << " decisions in " << schedulerBatches << " batches (" << static_cast<double>(schedulerDecisions) / schedulerBatches << " per batch)" << endl;
+    }
+
+    // every hand's trace for later reuse
+    if (RECORD_HANDS) {
+
+        bool allFit = true;
+        for (const ChunkTrace& trace : chunkTraces) {
+            allFit = allFit && trace.allFit();
+        }
+
+        HandTraceHeader header = newTraceHeader(settings.seed, rounds, GAME_COUNT, DECK_COUNT, SHUFFLE_EVERY_N_DECKS, STARTING_BAL, PAYOUTS, chart);
+        if (!allFit || !writeHandTrace(HANDS_PATH, header, chunkTraces)) {
+
+            cout << "Couldn't write the hand trace to " << HANDS_PATH << endl;
+            return 1;
+
+        }
+        chunkTraces.clear();
+
+    }
+
+    // edge per hand confidence interval
+    const double EDGE = handStats.getMean();
+    const double EDGE_SE = handStats.getStandardError();
+
+    // average final balance of the eval's own betting
+    const double AVERAGE_BAL = bankrolls.at(0).finalBalance.getStats().getMean();
+
+    // save eval info to file
+    ofstream outfile(SAVE_PATH);
+
+    // write out all eval params
+    outfile << "Evaluation for Chart" << CHART_ID << endl << endl;
+    writeEvalSettings(outfile, rounds, settings, targetMet);
+    if (RECORD_HANDS) {
+        outfile << "Hand trace: " << HANDS_PATH << endl;
+    }
+    if (REUSE_HANDS) {
+        outfile << "Hands reused from " << handTracePath(reuseSpec) << ": " << replayedHands << " of " << handStats.getCount() << " played again for " << changedCount << " changed cells" << endl;
+    }
+    outfile << "Results:" << endl;
+    outfile << "\tAverage final balance: $" << AVERAGE_BAL << endl;
+    outfile << "\tAverage balance increase: $" << (AVERAGE_BAL - STARTING_BAL) << " | " << (AVERAGE_BAL - STARTING_BAL) / STARTING_BAL * 100 << "%" << endl;
+    outfile << "\tHands played: " << handStats.getCount() << endl;
+    outfile << "\tEdge per hand: " << EDGE * 100 << "% of bet" << endl;
+    outfile << "\tStandard error: " << EDGE_SE * 100 << "%" << endl;
+    outfile << "\t95% CI: [" << (EDGE - CI_Z * EDGE_SE) * 100 << "%, " << (EDGE + CI_Z * EDGE_SE) * 100 << "%]" << endl;
+    outfile << "\tRisk of ruin: " << 100.0 * bankrolls.at(0).brokeRounds / rounds << "% of rounds" << endl;
+    outfile << "\tFinal balance 5th / 50th / 95th percentile: $" << bankrolls.at(0).finalBalance.getQuantile(0.05) << " / $" << bankrolls.at(0).finalBalance.getQuantile(0.5) << " / $" << bankrolls.at(0).finalBalance.getQuantile(0.95) << endl;
+    outfile << "\tAverage max drawdown: $" << bankrolls.at(0).maxDrawdown.getStats().getMean() << endl;
+
+    // results by hi-lo true count at the start of each hand
+    if (COUNTING) {
+
+        outfile << "Count play (hi-lo true count at the start of each hand):" << endl;
+        if (!countCharts.empty()) {
+            outfile << "\tCharts by true count: " << countCharts << endl;
+        }
+        if (!deviationsPath.empty()) {
+            outfile << "\tIndex plays: " << deviationsPath << endl;
+        }
+        if (!betRamp.empty()) {
+            outfile << "\tBet ramp (true count:units): " << betRamp << endl;
+        }
+        outfile << "\tEdge per unit bet with the ramp: " << unitsWon / unitsBet * 100 << "%" << endl;
+        outfile << "\t" << left << setw(10) << "count" << right << setw(12) << "hands %" << setw(12) << "units" << setw(12) << "edge %" << setw(12) << "+/- 95%" << endl;
+        for (int b = 0; b < COUNT_BUCKET_COUNT; b ++) {
+
+            outfile << "\t" << left << setw(10) << bucketLabel(b) << right;
+            outfile << setw(12) << 100.0 * bucketHands.at(b).getCount() / handStats.getCount();
+            outfile << setw(12) << countStrategy.getUnits(b);
+            outfile << setw(12) << bucketHands.at(b).getMean() * 100 << setw(12) << CI_Z * bucketHands.at(b).getStandardError() * 100 << endl;
+
+        }
+
+    }
+
+    // every betting strategy on the same hands
+    if (STRATEGY_COUNT > 1) {
+
+        outfile << "Betting strategies (same hands for each):" << endl;
+        outfile << "\t" << left << setw(40) << "strategy" << right << setw(14) << "avg balance" << setw(12) << "+/- 95%" << setw(12) << "broke %" << endl;
+        for (int k = 0; k < STRATEGY_COUNT; k ++) {
+
+            outfile << "\t" << left << setw(40) << bettingLabel(strategies.at(k)) << right;
+            outfile << setw(14) << bankrolls.at(k).finalBalance.getStats().getMean() << setw(12) << CI_Z * bankrolls.at(k).finalBalance.getStats().getStandardError();
+            outfile << setw(12) << 100.0 * bankrolls.at(k).brokeRounds / rounds << endl;
+
+        }
+
+    }
+
+    outfile.close();
+
+    // add the eval to the results store
+    if (!recordEval(SAVE_PATH, CHART_ID, evalId)) {
+        cout << "Couldn't add the eval to " << RESULTS_STORE_PATH << endl;
+    }
+
+    // machine readable summary next to the eval file
+    const string SUMMARY_PATH = SAVE_PATH.substr(0, SAVE_PATH.size() - 4) + "_summary.json";
+    ofstream summaryfile(SUMMARY_PATH);
+    summaryfile << "{" << endl;
+    summaryfile << "  \"chart\": \"" << CHART_ID << "\"," << endl;
+    summaryfile << "  \"seed\": " << settings.seed << "," << endl;
+    summaryfile << "  \"rounds\": " << rounds << "," << endl;
+    summaryfile << "  \"games_per_round\": " << GAME_COUNT << "," << endl;
+    summaryfile << "  \"starting_balance\": " << STARTING_BAL << "," << endl;
+    summaryfile << "  \"hands\": " << handStats.getCount() << "," << endl;
+    summaryfile << "  \"edge_per_hand\": {\"mean\": " << EDGE << ", \"se\": " << EDGE_SE << ", \"ci95\": [" << EDGE - CI_Z * EDGE_SE << ", " << EDGE + CI_Z * EDGE_SE << "]}," << endl;
+    summaryfile << "  \"strategies\": [" << endl;
+    for (int k = 0; k < STRATEGY_COUNT; k ++) {
+
+        const BankrollStats& bankroll = bankrolls.at(k);
+        summaryfile << "    {" << endl;
+        summaryfile << "      \"strategy\": \"" << bettingLabel(strategies.at(k)) << "\"," << endl;
+        summaryfile << "      \"ruin\": {\"rounds\": " << bankroll.brokeRounds << ", \"probability\": " << static_cast<double>(bankroll.brokeRounds) / rounds << "}," << endl;
+        writeJsonDistribution(summaryfile, "final_balance", bankroll.finalBalance, true);
+        writeJsonDistribution(summaryfile, "peak_balance", bankroll.peakBalance, true);
+        writeJsonDistribution(summaryfile, "max_drawdown", bankroll.maxDrawdown, true);
+        writeJsonDistribution(summaryfile, "time_to_ruin", bankroll.ruinGame, false);
+        summaryfile << "    }" << ((k + 1 < STRATEGY_COUNT) ? "," : "") << endl;
+
+    }
+    summaryfile << "  ]" << endl;
+    summaryfile << "}" << endl;
+
+    // event counts and trace next to the summary
+    writeCounterFiles(SAVE_PATH.substr(0, SAVE_PATH.size() - 4));
+    BJ_TRACE_WRITE(SAVE_PATH.substr(0, SAVE_PATH.size() - 4) + "_trace.json");
+
+    cout << "Played " << handStats.getCount() << " hands in " << PLAY_SECONDS << " s (" << handStats.getCount() / PLAY_SECONDS << " hands/sec)" << endl;
+    cout << "Evaluation complete." << endl;
+
+    return finishAllocReport(SAVE_PATH.substr(0, SAVE_PATH.size() - 4), handStats.getCount(), settings);
 }
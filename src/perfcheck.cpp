@@ -0,0 +1,449 @@
+/*
+    Author: Franklin Doane
+    Date Created: 18 October 2026
+    Purpose: times fixed seed training and eval workloads and the hot path benchmarks,
+             compares them to a stored baseline and flags regressions
+*/
+
+// imports
+#include "HotPaths.h"
+#include "Options.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <ctime>
+#include <cmath>
+#include <algorithm>
+
+// namespace
+using std::cout, std::endl;
+using std::ifstream, std::ofstream;
+using std::stringstream;
+using std::getline;
+using std::map;
+using std::setw, std::left, std::right, std::fixed, std::setprecision, std::showpos, std::noshowpos;
+using std::max, std::min, std::sort;
+using std::fabs;
+
+// CONSTANT PERFCHECK PARAMETERS
+const string DEFAULT_BASELINE_PATH = "../benchmarks/perf_baseline.csv";
+
+// fixed seed workloads, every run does exactly the same work
+const unsigned int WORKLOAD_SEED = 7;
+const int WORKLOAD_GAMES = 400000;
+const int WORKLOAD_ROUNDS = 200;
+const int WORKLOAD_REPETITIONS = 3;
+
+// hot path benchmark timing
+const double MICRO_WARMUP_SECONDS = 0.2;
+const double MICRO_REPETITION_SECONDS = 0.1;
+const int MICRO_REPETITIONS = 5;
+
+// every benchmark is run in this many passes spread over the whole check,
+// so a burst of other work on the machine only lands in some of them
+const int DEFAULT_PASSES = 3;
+
+// a result is a regression when it is slower by more than the larger of the minimum
+// threshold and this many standard deviations of the repetition spread, both in percent
+// the minimum covers drift between runs that the spread inside a run doesn't show
+const double DEFAULT_MIN_THRESHOLD = 10;
+const double DEFAULT_NOISE_SIGMAS = 3;
+
+// the noise term never raises the limit past this many times the minimum threshold,
+// so a noisy run still catches a benchmark that got much slower
+const double MAX_THRESHOLD_FACTOR = 2;
+
+// median absolute deviation times this estimates the standard deviation of normal noise
+const double MAD_TO_SD = 1.4826;
+
+// allocations per op can grow this much before they count as a regression
+const double ALLOCATION_TOLERANCE = 0.01;
+
+// one compared number
+struct PerfMetric {
+
+    // benchmark name and its unit (ns/op, hands/sec...)
+    string name;
+    string unit;
+
+    // rates are better higher, times lower
+    bool higherIsBetter;
+
+    // best value and its relative spread over every repetition
+    double value;
+    double noise;
+
+    // ns per op of every repetition
+    vector<double> repetitionNs;
+
+    // heap allocations per op
+    double allocations;
+
+};
+
+// metric of a benchmark result's best repetition, workloads are compared as rates and the rest as ns/op
+// the fastest repetition is the one other work on the machine got in the way of least
+PerfMetric toMetric(const BenchResult& result, bool rate) {
+
+    PerfMetric metric;
+    metric.name = result.name;
+    metric.unit = rate ? result.itemName + "/sec" : "ns/op";
+    metric.higherIsBetter = rate;
+    metric.value = rate ? ((result.minNs > 0) ? result.itemsPerOp * 1e9 / result.minNs : 0) : result.minNs;
+    metric.noise = 0;
+    metric.repetitionNs = result.repetitionNs;
+    metric.allocations = result.allocationsPerOp;
+
+    return metric;
+
+}
+
+// times the fixed seed training and eval workloads with filter in their name
+vector<BenchResult> runWorkloads(const string& filter) {
+
+    vector<BenchResult> results;
+    auto wanted = [&](const string& name) -> bool {
+        return filter.empty() || name.find(filter) != string::npos;
+    };
+
+    // training from a fresh agent as driver does it
+    if (wanted("training workload")) {
+
+        results.push_back(runFixedBenchmark("training workload", WORKLOAD_REPETITIONS, "games", WORKLOAD_GAMES, [&](BenchState& state) {
+
+            Dealer dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, WORKLOAD_SEED);
+            Game game(&dealer, SCORES);
+            BlackJackAgent agent(EPSILON, GAMMA, ALPHA);
+            StartSampler sampler(WORKLOAD_SEED);
+            vector<SplitInfo> splits;
+            srand(WORKLOAD_SEED);
+            agent.reserveTraining(TRAIN_EVERY);
+
+            for (int gameNum = 0; gameNum < WORKLOAD_GAMES; gameNum ++) {
+
+                playTrainingGame(&game, &agent, &sampler, NATURAL_STARTS, 0, splits);
+                if (gameNum % TRAIN_EVERY == 0) {
+                    agent.train();
+                }
+
+            }
+            doNotOptimize(agent.getTrainingCountTotal());
+
+        }));
+
+    }
+
+    // eval rounds of the exact chart with a constant bet
+    if (wanted("eval workload")) {
+
+        CompiledChart compiled;
+        compileSolvedChart(compiled);
+        vector<BettingStrategy> strategies = {{CONSTANT_BETTING, 0, M, 0, 0, 0}};
+
+        results.push_back(runFixedBenchmark("eval workload", WORKLOAD_REPETITIONS, "hands", WORKLOAD_ROUNDS * ROUND_GAMES, [&](BenchState& state) {
+
+            Dealer dealer(DECK_COUNT, SHUFFLE_EVERY_N_DECKS, WORKLOAD_SEED);
+            Game game(&dealer, SCORES);
+            BankrollTracks tracks(strategies);
+            vector<SplitInfo> splits;
+
+            double balance = 0;
+            for (int round = 0; round < WORKLOAD_ROUNDS; round ++) {
+
+                dealer.reshuffle();
+                tracks.startRound(STARTING_BAL);
+                for (int gameNum = 0; gameNum < ROUND_GAMES; gameNum ++) {
+
+                    if (!tracks.placeBets(gameNum, 1)) {
+                        break;
+                    }
+                    tracks.settle(playChartHand(&game, compiled, splits));
+
+                }
+                balance += tracks.getBalance(0);
+
+            }
+            doNotOptimize(balance);
+
+        }));
+
+    }
+
+    return results;
+
+}
+
+// median of a list of values
+double median(vector<double> values) {
+
+    if (values.empty()) {
+        return 0;
+    }
+
+    sort(values.begin(), values.end());
+    int middle = values.size() / 2;
+    return (values.size() % 2 == 1) ? values.at(middle) : (values.at(middle - 1) + values.at(middle)) / 2;
+
+}
+
+// relative spread of repetition times, from their median absolute deviation
+// a few repetitions hit by other work on the machine don't blow it up the way they do a standard deviation
+double relativeNoise(const vector<double>& repetitionNs) {
+
+    double middle = median(repetitionNs);
+    if (middle <= 0 || repetitionNs.size() < 2) {
+        return 0;
+    }
+
+    vector<double> deviations;
+    for (double ns : repetitionNs) {
+        deviations.push_back(fabs(ns - middle));
+    }
+
+    return MAD_TO_SD * median(deviations) / middle;
+
+}
+
+// best of the passes for each metric, with the spread of every pass's repetitions as its noise
+// every pass has the same metrics in the same order
+vector<PerfMetric> combinePasses(const vector<vector<PerfMetric>>& passes) {
+
+    vector<PerfMetric> metrics = passes.at(0);
+    for (unsigned int m = 0; m < metrics.size(); m ++) {
+
+        vector<double> repetitionNs;
+        for (const vector<PerfMetric>& pass : passes) {
+
+            const PerfMetric& metric = pass.at(m);
+            repetitionNs.insert(repetitionNs.end(), metric.repetitionNs.begin(), metric.repetitionNs.end());
+            if (metric.higherIsBetter ? metric.value > metrics.at(m).value : metric.value < metrics.at(m).value) {
+                metrics.at(m).value = metric.value;
+            }
+            metrics.at(m).allocations = max(metrics.at(m).allocations, metric.allocations);
+
+        }
+        metrics.at(m).repetitionNs = repetitionNs;
+        metrics.at(m).noise = relativeNoise(repetitionNs);
+
+    }
+
+    return metrics;
+
+}
+
+// cpu model of this machine from /proc/cpuinfo, baselines only mean something on the same one
+string cpuModel() {
+
+    ifstream infile("/proc/cpuinfo");
+    string line;
+    while (getline(infile, line)) {
+
+        if (line.compare(0, 10, "model name") == 0 && line.find(':') != string::npos) {
+            return line.substr(line.find(':') + 2);
+        }
+
+    }
+
+    return "unknown";
+
+}
+
+// writes metrics as a baseline csv with the machine they were taken on
+bool writeBaseline(const string& path, const vector<PerfMetric>& metrics) {
+
+    ofstream outfile(path);
+    outfile << setprecision(8);
+
+    outfile << "# perfcheck baseline, rewrite with perfcheck --update" << endl;
+    outfile << "# cpu: " << cpuModel() << endl;
+    outfile << "# compiler: " << __VERSION__ << endl;
+    outfile << "name,unit,value,noise,allocations" << endl;
+    for (const PerfMetric& metric : metrics) {
+        outfile << metric.name << "," << metric.unit << "," << metric.value << "," << metric.noise << "," << metric.allocations << endl;
+    }
+
+    return outfile.good();
+
+}
+
+// reads a baseline csv into metrics by name and the cpu it was taken on
+// returns false if the file can't be opened or a line can't be read
+bool readBaseline(const string& path, map<string, PerfMetric>& metrics, string& cpu) {
+
+    ifstream infile(path);
+    if (!infile.is_open()) {
+        return false;
+    }
+
+    string line;
+    bool header = true;
+    while (getline(infile, line)) {
+
+        // machine notes
+        if (line.compare(0, 7, "# cpu: ") == 0) {
+            cpu = line.substr(7);
+        }
+        if (line.empty() || line.at(0) == '#') {
+            continue;
+        }
+
+        // column names
+        if (header) {
+            header = false;
+            continue;
+        }
+
+        // name,unit,value,noise,allocations
+        stringstream lineStream(line);
+        PerfMetric metric;
+        string value;
+        string noise;
+        string allocations;
+        if (!getline(lineStream, metric.name, ',') || !getline(lineStream, metric.unit, ',') || !getline(lineStream, value, ',') || !getline(lineStream, noise, ',') || !getline(lineStream, allocations, ',')) {
+            return false;
+        }
+        metric.higherIsBetter = metric.unit != "ns/op";
+        metric.value = atof(value.c_str());
+        metric.noise = atof(noise.c_str());
+        metric.allocations = atof(allocations.c_str());
+        metrics[metric.name] = metric;
+
+    }
+
+    return true;
+
+}
+
+// prints how each metric moved from the baseline
+// returns the number of regressions
+int printComparison(const vector<PerfMetric>& metrics, const map<string, PerfMetric>& baseline, double minThreshold, double sigmas) {
+
+    int regressions = 0;
+
+    cout << left << setw(28) << "benchmark" << setw(14) << "unit" << right << setw(16) << "baseline" << setw(16) << "current";
+    cout << setw(11) << "slower %" << setw(10) << "limit %" << setw(14) << "allocs/op" << "  status" << endl;
+    for (const PerfMetric& metric : metrics) {
+
+        cout << left << setw(28) << metric.name << setw(14) << metric.unit << right << fixed;
+
+        // nothing to compare to
+        map<string, PerfMetric>::const_iterator found = baseline.find(metric.name);
+        if (found == baseline.end() || found->second.value <= 0 || metric.value <= 0) {
+
+            cout << setw(16) << "-" << setw(16) << setprecision(1) << metric.value << setw(11) << "-" << setw(10) << "-";
+            cout << setw(14) << setprecision(2) << metric.allocations << "  new" << endl;
+            continue;
+
+        }
+        const PerfMetric& base = found->second;
+
+        // time taken compared to the baseline, in percent
+        double slower = metric.higherIsBetter ? (base.value / metric.value - 1) * 100 : (metric.value / base.value - 1) * 100;
+
+        // noise of both runs together, capped so it can't hide a large slowdown
+        double limit = max(minThreshold, sigmas * 100 * sqrt(base.noise * base.noise + metric.noise * metric.noise));
+        limit = min(limit, MAX_THRESHOLD_FACTOR * minThreshold);
+
+        // status, allocations are counted exactly so any growth is a regression
+        bool slowed = slower > limit;
+        bool moreAllocations = metric.allocations > base.allocations + ALLOCATION_TOLERANCE;
+        string status = slowed ? "REGRESSION" : ((slower < -limit) ? "faster" : "ok");
+        if (moreAllocations) {
+            status = slowed ? "REGRESSION, MORE ALLOCS" : "MORE ALLOCS";
+        }
+        if (slowed || moreAllocations) {
+            regressions ++;
+        }
+
+        cout << setw(16) << setprecision(1) << base.value << setw(16) << metric.value;
+        cout << setw(11) << setprecision(1) << showpos << slower << noshowpos << setw(10) << limit;
+        cout << setw(14) << setprecision(2) << metric.allocations << "  " << status << endl;
+
+    }
+
+    return regressions;
+
+}
+
+// main
+// usage: perfcheck.exe [--baseline path] [--update] [--filter text] [--passes n] [--min-threshold percent] [--sigmas n]
+// compares to ../benchmarks/perf_baseline.csv, or the --baseline path, and returns 1 on a regression
+// the limit for each benchmark is between the minimum threshold and twice it, depending on its noise
+// --update writes the run as the new baseline instead
+int main(int argc, char* argv[]) {
+
+    // baseline file
+    string baselinePath = DEFAULT_BASELINE_PATH;
+    readOption(argc, argv, "baseline", baselinePath);
+    const bool UPDATE = hasFlag(argc, argv, "update");
+
+    // only run benchmarks with this in their name
+    string filter;
+    readOption(argc, argv, "filter", filter);
+
+    // regression thresholds
+    const double MIN_THRESHOLD = readNumberOption(argc, argv, "min-threshold", DEFAULT_MIN_THRESHOLD);
+    const double SIGMAS = readNumberOption(argc, argv, "sigmas", DEFAULT_NOISE_SIGMAS);
+    const int PASSES = max(1, static_cast<int>(readNumberOption(argc, argv, "passes", DEFAULT_PASSES)));
+
+    // baseline to compare against
+    map<string, PerfMetric> baseline;
+    string baselineCpu;
+    if (!UPDATE && !readBaseline(baselinePath, baseline, baselineCpu)) {
+
+        cout << "Can't read baseline " << baselinePath << ", write one with --update" << endl;
+        return 1;
+
+    }
+
+    // passes of every benchmark, each benchmark's best pass is compared
+    const BenchConfig MICRO_CONFIG = {MICRO_WARMUP_SECONDS, MICRO_REPETITION_SECONDS, MICRO_REPETITIONS};
+    vector<vector<PerfMetric>> passes;
+    for (int pass = 0; pass < PASSES; pass ++) {
+
+        cout << "Pass " << pass + 1 << " of " << PASSES << "..." << endl;
+        vector<PerfMetric> passMetrics;
+        for (const BenchResult& result : runWorkloads(filter)) {
+            passMetrics.push_back(toMetric(result, true));
+        }
+        for (const BenchResult& result : runHotPathBenchmarks(MICRO_CONFIG, filter)) {
+            passMetrics.push_back(toMetric(result, false));
+        }
+        passes.push_back(passMetrics);
+
+    }
+    vector<PerfMetric> metrics = combinePasses(passes);
+    cout << endl;
+
+    // new baseline
+    if (UPDATE) {
+
+        if (!writeBaseline(baselinePath, metrics)) {
+
+            cout << "Can't write " << baselinePath << endl;
+            return 1;
+
+        }
+        cout << "Baseline written to " << baselinePath << endl;
+        return 0;
+
+    }
+
+    // comparison
+    if (baselineCpu != cpuModel()) {
+        cout << "Warning: baseline was taken on " << baselineCpu << ", this is " << cpuModel() << endl << endl;
+    }
+    int regressions = printComparison(metrics, baseline, MIN_THRESHOLD, SIGMAS);
+    cout << endl;
+    if (regressions > 0) {
+
+        cout << regressions << " regression" << ((regressions > 1) ? "s" : "") << " against " << baselinePath << endl;
+        return 1;
+
+    }
+    cout << "No regressions against " << baselinePath << endl;
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+    Author: Franklin Doane
+    Date Created: 18 October 2026
+    Purpose: reads a chart's q log into learning curves of a cell and a timeline of policy flips
+*/
+
+// imports
+#include "BlackJackAgent.h"
+#include "ChartIO.h"
+#include "QLog.h"
+#include "Options.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// namespace
+using std::cout, std::endl;
+using std::setw, std::left, std::right;
+using std::stable_sort, std::min;
+
+// cells listed by flips when --top isn't given
+const int DEFAULT_TOP_CELLS = 15;
+
+// how a cell's chart choice moved over the log
+struct CellFlips {
+
+    int row;
+    int column;
+    int flips;
+    long long lastFlipGames;
+    int finalAction;
+
+};
+
+// path of a chart's q log from src
+string qLogPath(const string& chartId) {
+
+    return "../charts/Chart" + chartId + "/Chart" + chartId + "_qlog.bin";
+
+}
+
+// index of a label in a list of labels, -1 if missing
+int findLabel(const string labels[], int labelCount, const string& label) {
+
+    for (int i = 0; i < labelCount; i ++) {
+
+        if (labels[i] == label) {
+            return i;
+        }
+
+    }
+
+    return -1;
+
+}
+
+// prints the q values and training counts of one cell at every snapshot as csv
+int printCurve(const QLogReader& log, const string& cell) {
+
+    // <player hand>:<dealer card>
+    size_t colon = cell.find(':');
+    int row = (colon == string::npos) ? -1 : findLabel(PLAYER_HANDS, PLAYER_HAND_COUNT, cell.substr(0, colon));
+    int column = (colon == string::npos) ? -1 : findLabel(DEALER_HANDS, DEALER_HAND_COUNT, cell.substr(colon + 1));
+    if (row == -1 || column == -1) {
+
+        cout << "Can't find cell " << cell << ", give it as <player hand>:<dealer card> like A-7:10" << endl;
+        return 1;
+
+    }
+
+    cout << "games,training count";
+    for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+        cout << ",Q " << ACTION_NAMES[k];
+    }
+    for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+        cout << ",N " << ACTION_NAMES[k];
+    }
+    cout << ",chart" << endl;
+
+    // chart choice of the cell at each snapshot
+    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+    bool decoded = log.forEachSnapshot([&](const QLogSnapshot& snapshot) {
+
+        buildChart(snapshot.qTable, chart);
+        cout << snapshot.games << "," << snapshot.trainingCount;
+        for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+            cout << "," << snapshot.qTable[row][column][k];
+        }
+        for (int k = 0; k < ACTION_TYPE_COUNT; k ++) {
+            cout << "," << snapshot.counts[row][column][k];
+        }
+        cout << "," << ACTION_NAMES[chart[row][column]] << endl;
+
+    });
+
+    return decoded ? 0 : 1;
+
+}
+
+// prints when the chart stopped changing and the cells that changed the most
+// with --timeline, every snapshot's count of changed cells as csv instead
+int printFlips(const QLogReader& log, int topCells, bool timeline) {
+
+    vector<CellFlips> cells;
+    for (int i = 0; i < PLAYER_HAND_COUNT; i ++) {
+        for (int j = 0; j < DEALER_HAND_COUNT; j ++) {
+            cells.push_back({i, j, 0, 0, -1});
+        }
+    }
+
+    if (timeline) {
+        cout << "games,training count,cells changed" << endl;
+    }
+
+    // chart of each snapshot against the one before
+    int chart[PLAYER_HAND_COUNT][DEALER_HAND_COUNT];
+    long long lastChangeGames = 0;
+    long long lastGames = 0;
+    bool decoded = log.forEachSnapshot([&](const QLogSnapshot& snapshot) {
+
+        buildChart(snapshot.qTable, chart);
+        int changed = 0;
+        for (CellFlips& cell : cells) {
+
+            int action = chart[cell.row][cell.column];
+            if (cell.finalAction != -1 && action != cell.finalAction) {
+
+                cell.flips ++;
+                cell.lastFlipGames = snapshot.games;
+                changed ++;
+
+            }
+            cell.finalAction = action;
+
+        }
+
+        if (changed > 0) {
+            lastChangeGames = snapshot.games;
+        }
+        lastGames = snapshot.games;
+        if (timeline) {
+            cout << snapshot.games << "," << snapshot.trainingCount << "," << changed << endl;
+        }
+
+    });
+    if (!decoded || timeline) {
+        return decoded ? 0 : 1;
+    }
+
+    // whole log
+    int flippedCells = 0;
+    int totalFlips = 0;
+    for (const CellFlips& cell : cells) {
+
+        flippedCells += (cell.flips > 0);
+        totalFlips += cell.flips;
+
+    }
+    cout << log.getSnapshotCount() << " snapshots over " << lastGames << " games (" << log.getSize() << " bytes)" << endl;
+    cout << "Chart last changed at game " << lastChangeGames << endl;
+    cout << totalFlips << " flips in " << flippedCells << " of " << cells.size() << " cells" << endl << endl;
+
+    // cells that flipped the most, latest last flip first among ties
+    stable_sort(cells.begin(), cells.end(), [](const CellFlips& a, const CellFlips& b) -> bool {
+
+        if (a.flips != b.flips) {
+            return a.flips > b.flips;
+        }
+        return a.lastFlipGames > b.lastFlipGames;
+
+    });
+
+    cout << left << setw(10) << "player" << setw(8) << "dealer" << right << setw(8) << "flips" << setw(16) << "last flip" << "  " << "final" << endl;
+    for (int c = 0; c < min(topCells, static_cast<int>(cells.size())); c ++) {
+
+        const CellFlips& cell = cells.at(c);
+        if (cell.flips == 0) {
+            break;
+        }
+        cout << left << setw(10) << PLAYER_HANDS[cell.row] << setw(8) << DEALER_HANDS[cell.column] << right;
+        cout << setw(8) << cell.flips << setw(16) << cell.lastFlipGames << "  " << ACTION_NAMES[cell.finalAction] << endl;
+
+    }
+
+    return 0;
+
+}
+
+// main
+// usage: qlog.exe <chart id> [--path file] [--cell <player hand>:<dealer card>] [--timeline] [--top n]
+// reads ../charts/Chart<id>/Chart<id>_qlog.bin, or the --path file
+// without options it says when the chart stopped changing and lists the cells that flipped the most,
+// --cell prints that cell's q values and counts at every snapshot as csv,
+// and --timeline prints how many cells changed at every snapshot as csv
+int main(int argc, char* argv[]) {
+
+    if (argc < 2) {
+
+        cout << "usage: qlog.exe <chart id> [--path file] [--cell <player hand>:<dealer card>] [--timeline] [--top n]" << endl;
+        return 1;
+
+    }
+
+    // log to read
+    string path = qLogPath(argv[1]);
+    readOption(argc, argv, "path", path);
+
+    QLogReader log;
+    string error;
+    if (!log.open(path, error)) {
+
+        cout << "Can't read the q log: " << error << endl;
+        return 1;
+
+    }
+
+    string cell;
+    if (readOption(argc, argv, "cell", cell)) {
+        return printCurve(log, cell);
+    }
+
+    return printFlips(log, readNumberOption(argc, argv, "top", DEFAULT_TOP_CELLS), hasFlag(argc, argv, "timeline"));
+
+}
@@ -0,0 +1,420 @@
+/*
+    Author: Franklin Doane
+    Date Created: 18 October 2026
+    Purpose: imports the chart files into the results store and filters and sorts its runs
+*/
+
+// imports
+#include "ResultsStore.h"
+#include "Options.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <chrono>
+
+// namespace
+using std::cout, std::endl;
+using std::setw, std::left;
+using std::set;
+using std::max, std::stable_sort;
+using std::chrono::steady_clock, std::chrono::duration;
+
+// columns shown when --fields isn't given
+const string DEFAULT_EVAL_FIELDS = "chart,eval_id,note,alpha,epsilon_coefficient,games,update_target,hands,edge,edge_se,average_balance";
+const string DEFAULT_TRAIN_FIELDS = "chart,note,alpha,gamma,epsilon_coefficient,games,train_every,update_target,replay_size,games_per_sec";
+const string DEFAULT_NOTE_FIELDS = "text";
+
+// space between columns
+const int COLUMN_GAP = 2;
+
+// a --where condition, field then one of = != < > <= >= then value
+struct Condition {
+
+    string field;
+    string op;
+    string value;
+
+};
+
+// comparison operators, two character ones first so <= isn't read as <
+const string CONDITION_OPS[] = {"!=", "<=", ">=", "=", "<", ">"};
+const int CONDITION_OP_COUNT = 6;
+
+// splits text on commas
+vector<string> splitList(const string& text) {
+
+    vector<string> parts;
+    stringstream textStream(text);
+    string part;
+    while (getline(textStream, part, ',')) {
+
+        if (!trimmed(part).empty()) {
+            parts.push_back(trimmed(part));
+        }
+
+    }
+
+    return parts;
+
+}
+
+// reads comma separated conditions like alpha=0.004,edge>-8
+// returns false if one has no operator
+bool parseConditions(const string& text, vector<Condition>& conditions) {
+
+    for (const string& part : splitList(text)) {
+
+        // first operator in the condition
+        size_t at = string::npos;
+        string op;
+        for (int o = 0; o < CONDITION_OP_COUNT; o ++) {
+
+            size_t found = part.find(CONDITION_OPS[o]);
+            if (found != string::npos && (found < at || (found == at && CONDITION_OPS[o].size() > op.size()))) {
+
+                at = found;
+                op = CONDITION_OPS[o];
+
+            }
+
+        }
+        if (at == string::npos || at == 0) {
+            return false;
+        }
+
+        conditions.push_back({trimmed(part.substr(0, at)), op, trimmed(part.substr(at + op.size()))});
+
+    }
+
+    return true;
+
+}
+
+// compares two values, by number when both are numbers
+// returns -1, 0 or 1
+int compareValues(const string& a, const string& b) {
+
+    double aNumber, bNumber;
+    if (parseNumber(a, aNumber) && parseNumber(b, bNumber)) {
+        return (aNumber < bNumber) ? -1 : (aNumber > bNumber) ? 1 : 0;
+    }
+
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+
+}
+
+// true if a row meets a condition, a row without the field only meets !=
+bool meetsCondition(const ResultRecord& row, const Condition& condition) {
+
+    string value = recordField(row, condition.field);
+    if (value.empty()) {
+        return condition.op == "!=";
+    }
+
+    int order = compareValues(value, condition.value);
+    if (condition.op == "=") {
+        return order == 0;
+    }
+    if (condition.op == "!=") {
+        return order != 0;
+    }
+    if (condition.op == "<") {
+        return order < 0;
+    }
+    if (condition.op == ">") {
+        return order > 0;
+    }
+    if (condition.op == "<=") {
+        return order <= 0;
+    }
+    return order >= 0;
+
+}
+
+// charts with a record where a field equals a value, found with the field index
+set<string> chartsWithValue(const ResultsStore& store, const string& field, const string& value) {
+
+    set<string> charts;
+    for (int r : store.findField(field, value)) {
+        charts.insert(recordField(store.getRecord(r), "chart"));
+    }
+
+    return charts;
+
+}
+
+// query rows of a kind, evals with the fields of their chart's newest training run added
+// only charts in the candidate list are looked at, every chart if there's no list
+// records replaced by a newer one of the same file are left out unless history is set
+vector<ResultRecord> buildRows(const ResultsStore& store, const string& kind, const set<string>* candidates, bool history) {
+
+    // record numbers to look at
+    vector<int> recordNumbers;
+    if (candidates) {
+
+        for (const string& chartId : *candidates) {
+
+            const vector<int>& chartRecords = store.findChart(chartId);
+            recordNumbers.insert(recordNumbers.end(), chartRecords.begin(), chartRecords.end());
+
+        }
+        sort(recordNumbers.begin(), recordNumbers.end());
+
+    }
+    else {
+
+        for (unsigned int r = 0; r < store.getRecords().size(); r ++) {
+            recordNumbers.push_back(r);
+        }
+
+    }
+
+    vector<ResultRecord> rows;
+    for (int r : recordNumbers) {
+
+        const ResultRecord& record = store.getRecord(r);
+        if (record.kind != kind || (!history && !store.isCurrent(r))) {
+            continue;
+        }
+
+        ResultRecord row = record;
+        if (kind == EVAL_RECORD) {
+
+            // eval fields win over training fields of the same name
+            int training = store.findLatest(recordField(record, "chart"), TRAIN_RECORD);
+            if (training >= 0) {
+                row.fields.insert(store.getRecord(training).fields.begin(), store.getRecord(training).fields.end());
+            }
+
+        }
+        rows.push_back(row);
+
+    }
+
+    return rows;
+
+}
+
+// prints rows as a table of the fields asked for
+void printRows(const vector<ResultRecord>& rows, const vector<string>& fields) {
+
+    // column widths
+    vector<size_t> widths;
+    for (const string& field : fields) {
+
+        size_t width = field.size();
+        for (const ResultRecord& row : rows) {
+            width = max(width, recordField(row, field).size());
+        }
+        widths.push_back(width + COLUMN_GAP);
+
+    }
+
+    cout << left;
+    for (unsigned int f = 0; f < fields.size(); f ++) {
+        cout << setw(widths.at(f)) << fields.at(f);
+    }
+    cout << endl;
+    for (const ResultRecord& row : rows) {
+
+        for (unsigned int f = 0; f < fields.size(); f ++) {
+
+            string value = recordField(row, fields.at(f));
+            cout << setw(widths.at(f)) << (value.empty() ? "-" : value);
+
+        }
+        cout << endl;
+
+    }
+
+}
+
+// filters and sorts the rows of one kind
+int runQuery(const ResultsStore& store, int argc, char* argv[], steady_clock::time_point start) {
+
+    // kind of row
+    string kind = EVAL_RECORD;
+    readOption(argc, argv, "kind", kind);
+    if (kind != EVAL_RECORD && kind != TRAIN_RECORD && kind != NOTE_RECORD) {
+
+        cout << "Unknown kind " << kind << ", pick one of: " << EVAL_RECORD << " " << TRAIN_RECORD << " " << NOTE_RECORD << endl;
+        return 1;
+
+    }
+
+    // conditions
+    vector<Condition> conditions;
+    string where;
+    if (readOption(argc, argv, "where", where) && !parseConditions(where, conditions)) {
+
+        cout << "Can't read conditions: " << where << endl;
+        return 1;
+
+    }
+    string chartId;
+    if (readOption(argc, argv, "chart", chartId)) {
+        conditions.push_back({"chart", "=", chartId});
+    }
+
+    // the index narrows the charts to those with every = condition's value in one of their records,
+    // the conditions themselves are checked on the rows after
+    // notes don't belong to a chart, so they're never narrowed and every note is checked
+    set<string> candidates;
+    bool narrowed = false;
+    for (const Condition& condition : conditions) {
+
+        if (condition.op != "=" || kind == NOTE_RECORD) {
+            continue;
+        }
+
+        set<string> charts = chartsWithValue(store, condition.field, condition.value);
+        if (narrowed) {
+
+            set<string> both;
+            for (const string& chart : charts) {
+
+                if (candidates.count(chart)) {
+                    both.insert(chart);
+                }
+
+            }
+            candidates = both;
+
+        }
+        else {
+
+            candidates = charts;
+            narrowed = true;
+
+        }
+
+    }
+
+    // rows meeting every condition
+    vector<ResultRecord> rows;
+    for (const ResultRecord& row : buildRows(store, kind, narrowed ? &candidates : nullptr, hasFlag(argc, argv, "history"))) {
+
+        bool meets = true;
+        for (const Condition& condition : conditions) {
+            meets = meets && meetsCondition(row, condition);
+        }
+        if (meets) {
+            rows.push_back(row);
+        }
+
+    }
+
+    // sort, rows without the field go last either way
+    string sortField;
+    if (readOption(argc, argv, "sort", sortField)) {
+
+        const bool DESCENDING = hasFlag(argc, argv, "desc");
+        stable_sort(rows.begin(), rows.end(), [&](const ResultRecord& a, const ResultRecord& b) -> bool {
+
+            string aValue = recordField(a, sortField);
+            string bValue = recordField(b, sortField);
+            if (aValue.empty() || bValue.empty()) {
+                return !aValue.empty() && bValue.empty();
+            }
+            int order = compareValues(aValue, bValue);
+            return DESCENDING ? order > 0 : order < 0;
+
+        });
+
+    }
+
+    // first rows only
+    const int LIMIT = readNumberOption(argc, argv, "limit", 0);
+    const int MATCHED = rows.size();
+    if (LIMIT > 0 && LIMIT < MATCHED) {
+        rows.resize(LIMIT);
+    }
+
+    // columns
+    string fieldList = (kind == EVAL_RECORD) ? DEFAULT_EVAL_FIELDS : (kind == TRAIN_RECORD) ? DEFAULT_TRAIN_FIELDS : DEFAULT_NOTE_FIELDS;
+    readOption(argc, argv, "fields", fieldList);
+
+    const double QUERY_MS = duration<double, std::milli>(steady_clock::now() - start).count();
+    printRows(rows, splitList(fieldList));
+    cout << endl << MATCHED << " of " << store.getRecords().size() << " records matched in " << QUERY_MS << " ms" << endl;
+
+    return 0;
+
+}
+
+// prints the records of a chart with all of their fields, with replaced ones only if history is set
+int showChart(const ResultsStore& store, const string& chartId, bool history) {
+
+    const vector<int>& chartRecords = store.findChart(chartId);
+    if (chartRecords.empty()) {
+
+        cout << "No records of Chart" << chartId << " in " << store.getPath() << endl;
+        return 1;
+
+    }
+
+    for (int r : chartRecords) {
+
+        if (!history && !store.isCurrent(r)) {
+            continue;
+        }
+
+        const ResultRecord& record = store.getRecord(r);
+        cout << record.kind << " (" << recordField(record, "source") << ", recorded " << recordField(record, "recorded") << (store.isCurrent(r) ? "" : ", replaced") << ")" << endl;
+        for (const auto& [field, value] : record.fields) {
+
+            if (field != "source" && field != "recorded") {
+                cout << "\t" << field << ": " << value << endl;
+            }
+
+        }
+
+    }
+
+    return 0;
+
+}
+
+// main
+// usage: results.exe import
+//        results.exe query [--kind eval|train|note] [--chart id] [--where field=value,field<value,...]
+//                          [--sort field] [--desc] [--fields a,b,...] [--limit n] [--history]
+//        results.exe show <chart id> [--history]
+// import adds the parameters and eval files of every chart and the lines of Chart_notes.txt
+// that aren't in the store yet, driver and eval add their own runs as they finish
+// eval rows carry the fields of their chart's newest training run, so
+// "query --where update_target=q --sort edge --desc" ranks charts by edge
+// conditions compare by number when both sides are numbers, and can use = != < > <= >=
+// a run written to the same file as an earlier one replaces it, --history lists both
+int main(int argc, char* argv[]) {
+
+    const string COMMAND = (argc > 1) ? argv[1] : "";
+
+    // whole store with its indexes
+    steady_clock::time_point start = steady_clock::now();
+    ResultsStore store(RESULTS_STORE_PATH);
+    store.load();
+
+    if (COMMAND == "import") {
+
+        int added = importChartFiles(store, "../charts", CHART_NOTES_PATH);
+        cout << "Added " << added << " records to " << RESULTS_STORE_PATH << " (" << store.getRecords().size() << " in all)" << endl;
+        return 0;
+
+    }
+
+    if (COMMAND == "query") {
+        return runQuery(store, argc, argv, start);
+    }
+
+    if (COMMAND == "show" && argc > 2) {
+        return showChart(store, argv[2], hasFlag(argc, argv, "history"));
+    }
+
+    cout << "usage: results.exe import | query [options] | show <chart id>" << endl;
+    return 1;
+
+}
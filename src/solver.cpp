@@ -0,0 +1,95 @@
+/*
+    Author: Franklin Doane
+    Date Created: 18 October 2026
+    Purpose: generate a blackjack chart from exact action values instead of q learning
+*/
+
+// imports
+#include "BlackJack.h"
+#include "BlackJackAgent.h"
+#include "Solver.h"
+#include "ChartIO.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+
+// namespace
+using std::cout, std::endl;
+using std::atoi;
+using std::chrono::steady_clock, std::chrono::duration;
+
+// note of what makes this chart unique
+const string CHART_NOTE = "exact solver";
+
+// CONSTANT BLACKJACK GAME PARAMETERS
+const Scoring SCORES = {
+
+    1.5,  // blackjack;
+    2,    // doubleWin;
+    1,    // win;
+    -1,   // loss;
+    -2,   // doubleLoss;
+    0     // push;
+
+};
+
+// main
+// usage: solver.exe <chart id> [deck count, 0 or missing for infinite]
+int main(int argc, char* argv[]) {
+
+    // main chart files are named in writeChartFiles
+    const string CHART_ID = argv[1];
+
+    // number of decks to solve for
+    const int DECK_COUNT = (argc > 2) ? atoi(argv[2]) : 0;
+
+    // text file containing all the parameters of creation
+    const string PARAM_FILE_NAME = CHART_ID + "_parameters.txt";
+
+    // solve table
+    cout << "Solving chart..." << endl;
+    steady_clock::time_point start = steady_clock::now();
+
+    StrategySolver* solver = new StrategySolver(SCORES, DECK_COUNT);
+    solver->solve();
+
+    double solveMs = duration<double, std::milli>(steady_clock::now() - start).count();
+    cout << "Solve complete in " << solveMs << " ms." << endl << endl;
+
+    // the solver has no training examples, backing charts are all zero
+    static int counts[PLAYER_HAND_COUNT][DEALER_HAND_COUNT][ACTION_TYPE_COUNT] = {};
+
+    // build chart out of solved values
+    writeChartFiles(CHART_ID, solver->getQTable(), counts);
+
+    // print all solve parameters
+    ofstream outfile(PARAM_FILE_NAME);
+
+    outfile << "Solver parameters for chart #" << CHART_ID << endl;
+    outfile << "\tChart note: " << CHART_NOTE << endl << endl;
+    outfile << "Method: exact recursion, split resplits by value iteration" << endl;
+    if (DECK_COUNT == 0) {
+        outfile << "Deck count: infinite" << endl;
+    }
+    else {
+        outfile << "Deck count: " << DECK_COUNT << " (composition dependent, fresh shoe)" << endl;
+    }
+    outfile << "Split values: total of both hands" << endl;
+    outfile << "Backing counts: none (not trained)" << endl;
+    outfile << "Solve time: " << solveMs << " ms" << endl;
+    outfile << "Rewards:" << endl;
+    outfile << "\tWin: " << SCORES.win << endl;
+    outfile << "\tBlackjack: " << SCORES.blackjack << endl;
+    outfile << "\tDouble: " << SCORES.doubleWin << endl;
+    outfile << "\tLoss: " << SCORES.loss << endl;
+    outfile << "\tDouble loss: " << SCORES.doubleLoss << endl;
+    outfile << "\tPush: " << SCORES.push << endl;
+
+    outfile.close();
+
+    // cleanup
+    delete solver;
+
+    return 0;
+}